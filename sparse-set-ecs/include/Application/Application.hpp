@@ -1,11 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <string>
 
 #include "Clock.hpp"
+#include "FrameArena.hpp"
+#include "FramePacer.hpp"
 #include "ICore.hpp"
+#include "Profiler.hpp"
 #include "IRenderer.hpp"
+#include "RecordingRenderer.hpp"
+#include "RenderCommandList.hpp"
+#include "RenderThread.hpp"
 
 class Application {
 private:
@@ -13,6 +22,23 @@ private:
     Clock m_frameClock;
     bool m_running;
 
+    // fixed timestep mode, off while m_fixedDeltaTime is 0
+    float m_fixedDeltaTime = 0.0f;
+    int m_maxStepsPerFrame = 0;
+    float m_accumulator = 0.0f;
+    float m_droppedTime = 0.0f;
+
+    std::unique_ptr<FramePacer> m_pacer;
+
+    std::string m_tracePath;
+    std::string m_summaryPath;
+
+    // pipelined mode: frames are recorded into one list while the other is drawn
+    bool m_pipelined = false;
+    bool m_recording = false;
+    RecordingRenderer m_recorder;
+    RenderCommandList m_frames[2];
+
 public:
     virtual ~Application() = default;
     explicit Application(std::unique_ptr<ICore> core)
@@ -68,7 +94,54 @@ public:
      */
     void end() {
         onEnd();
+
+        if (m_droppedTime > 0.0f) {
+            std::cout << "Simulation fell behind and dropped " << m_droppedTime << " s" << std::endl;
+        }
+
+        if (m_pacer && m_pacer->getFrameCount() > 0) {
+            std::cout << "Frame pacing: " << m_pacer->getAchievedFrameRate() << " FPS achieved of "
+                      << m_pacer->getTargetFrameRate() << " requested, worst frame "
+                      << m_pacer->getMaxFrameTime() * 1000.0 << " ms, "
+                      << m_pacer->getLateFrameCount() << " late, "
+                      << m_pacer->getSpinFraction() * 100.0 << "% of the wait spent spinning" << std::endl;
+        }
+
         m_core->shutdown();
+
+        const Histogram& frames = Profiler::getInstance().getFrameHistogram();
+        if (frames.getCount() > 0) {
+            std::cout << "Frame times: p50 " << frames.getPercentile(50.0) / 1e6
+                      << " ms, p95 " << frames.getPercentile(95.0) / 1e6
+                      << " ms, p99 " << frames.getPercentile(99.0) / 1e6
+                      << " ms, max " << frames.getMax() / 1e6
+                      << " ms, " << Profiler::getInstance().getSpikeCount() << " spikes" << std::endl;
+        }
+
+        const Histogram& allocations = Profiler::getInstance().getAllocationHistogram();
+        if (AllocationTracker::isHooked() && allocations.getCount() > 0) {
+            AllocationTracker::Counts pools = AllocationTracker::getContainerCounts();
+            std::cout << "Allocations per frame: p50 " << allocations.getPercentile(50.0)
+                      << ", max " << allocations.getMax()
+                      << "; component pools hold " << pools.bytes << " bytes after "
+                      << pools.allocations << " allocations" << std::endl;
+        }
+
+        if (!m_summaryPath.empty()) {
+            if (Profiler::getInstance().writeSummaryJson(m_summaryPath)) {
+                std::cout << "Wrote profile summary to " << m_summaryPath << std::endl;
+            } else {
+                std::cout << "Failed to write profile summary to " << m_summaryPath << std::endl;
+            }
+        }
+
+        if (!m_tracePath.empty()) {
+            if (Profiler::getInstance().writeChromeTrace(m_tracePath)) {
+                std::cout << "Wrote profile trace to " << m_tracePath << std::endl;
+            } else {
+                std::cout << "Failed to write profile trace to " << m_tracePath << std::endl;
+            }
+        }
     }
     
     /**
@@ -76,16 +149,35 @@ public:
      * Called from the program entry point.
      */
     void run() {
-        while (m_running && m_core->onPreFrame()) {
+        Profiler::getInstance().setThreadName("Main");
+
+        if (m_pipelined) {
+            runPipelined();
+            return;
+        }
+
+        while (m_running) {
+            Profiler::getInstance().beginFrame();
+
+            {
+                PROFILE_ZONE("onPreFrame");
+                if (!m_core->onPreFrame()) break;
+            }
+
             m_frameClock.updateLap();
-            float dt = std::clamp(m_frameClock.getDeltaTime(), 0.0f, 0.1f);
+            float dt = std::max(m_frameClock.getDeltaTime(), 0.0f);
 
-            onUpdate(dt);
-            onRender();
+            update(dt);
+            render();
 
-            trackFPS(dt);
+            {
+                PROFILE_ZONE("onPostFrame");
+                m_core->onPostFrame();
+            }
 
-            m_core->onPostFrame();
+            pace();
+            endFrame();
+            FrameArena::nextFrame();
         }
     }
 
@@ -93,24 +185,199 @@ public:
         m_running = false;
     }
 
+    /**
+     * When enabled, frame N + 1 is simulated while frame N is drawn on a render thread.
+     * onRender() then records into a command list instead of drawing, so frames reach the
+     * screen one frame later, and getRenderer().getViewBounds() reflects the camera as of
+     * the last frame handed to the render thread. Off by default, set before run().
+     */
+    void setPipelined(bool pipelined) {
+        m_pipelined = pipelined;
+    }
+
+    /**
+     * Caps the loop at framesPerSecond, sleeping rather than spinning between frames.
+     * 0 runs uncapped, as fast as the frames can be made.
+     */
+    void setTargetFrameRate(float framesPerSecond) {
+        if (framesPerSecond > 0.0f) {
+            m_pacer = std::make_unique<FramePacer>(framesPerSecond);
+        } else {
+            m_pacer.reset();
+        }
+    }
+
+    /**
+     * Switches onUpdate() to a constant dt of 1 / ticksPerSecond. Each frame runs as many
+     * ticks as the elapsed time allows, at most maxStepsPerFrame; time beyond that is dropped
+     * and reported at the end. onRender() should blend the last two simulation states with
+     * getInterpolationAlpha(). A rate of 0 returns to one variable dt update per frame.
+     */
+    void setFixedTimestep(float ticksPerSecond, int maxStepsPerFrame = 5) {
+        m_fixedDeltaTime = (ticksPerSecond > 0.0f) ? 1.0f / ticksPerSecond : 0.0f;
+        m_maxStepsPerFrame = std::max(maxStepsPerFrame, 1);
+        m_accumulator = 0.0f;
+    }
+
+    /**
+     * How far the frame is between the previous tick (0) and the last one (1).
+     * Always 1 without a fixed timestep, where rendering shows the latest state.
+     */
+    float getInterpolationAlpha() const {
+        if (m_fixedDeltaTime <= 0.0f) {
+            return 1.0f;
+        }
+        return m_accumulator / m_fixedDeltaTime;
+    }
+
+    /**
+     * The dt of every onUpdate() call in fixed timestep mode, 0 without one.
+     */
+    float getFixedDeltaTime() const {
+        return m_fixedDeltaTime;
+    }
+
+    /**
+     * Writes the profile of the last frames to path as Chrome trace JSON when the
+     * application ends. Empty, the default, writes nothing.
+     */
+    void setTraceOutput(const std::string& path) {
+        m_tracePath = path;
+    }
+
+    /**
+     * Writes the frame and per-zone time percentiles and the frame spikes of the run to
+     * path as JSON when the application ends. Empty, the default, writes nothing.
+     */
+    void setSummaryOutput(const std::string& path) {
+        m_summaryPath = path;
+    }
+
     IRenderer& getRenderer() {
+        if (m_recording) {
+            return m_recorder;
+        }
         return m_core->getRenderer();
     }
 
 private:
-    void trackFPS(float dt) {
-        static float frameTimeSum = 0.0f;
-        static int frameCount = 0;
-
-        frameTimeSum += dt;
-        frameCount++;
-
-        if (frameCount >= 100) {
-            float frameTimeAvg = frameTimeSum / frameCount;
-            frameTimeSum = 0.0f;
-            frameCount = 0;
-            float FPS = 1.0f / frameTimeAvg;
-            std::cout << "FPS: " << FPS << '\n';
+    /**
+     * Advances the simulation by the frame time dt, in one call or in fixed ticks.
+     * A single call gets at most 0.1 s, so a stall doesn't make the simulation jump.
+     */
+    void update(float dt) {
+        if (m_fixedDeltaTime <= 0.0f) {
+            PROFILE_ZONE("onUpdate");
+            onUpdate(std::min(dt, 0.1f));
+            return;
+        }
+
+        m_accumulator += dt;
+
+        for (int step = 0; step < m_maxStepsPerFrame && m_accumulator >= m_fixedDeltaTime; ++step) {
+            PROFILE_ZONE("onUpdate");
+            onUpdate(m_fixedDeltaTime);
+            m_accumulator -= m_fixedDeltaTime;
+        }
+
+        // out of catch-up steps, keep only the partial tick
+        if (m_accumulator >= m_fixedDeltaTime) {
+            float behind = m_accumulator - std::fmod(m_accumulator, m_fixedDeltaTime);
+            m_droppedTime += behind;
+            m_accumulator -= behind;
+        }
+    }
+
+    void render() {
+        PROFILE_ZONE("onRender");
+        onRender();
+    }
+
+    void pace() {
+        if (m_pacer) {
+            PROFILE_ZONE("FramePacer::wait");
+            m_pacer->wait();
+        }
+    }
+
+    /**
+     * Closes the frame's profile, reports it if it was a spike, and prints a summary
+     * every 100 frames.
+     */
+    void endFrame() {
+        Profiler& profiler = Profiler::getInstance();
+
+        if (profiler.endFrame() && profiler.getSpikes().size() == profiler.getSpikeCount()) {
+            const Profiler::Spike& spike = profiler.getSpikes().back();
+            std::cout << "Frame spike: frame " << spike.frame << " took " << spike.frameTime / 1e6
+                      << " ms (median " << spike.frameMedian / 1e6 << " ms)";
+            if (spike.zone) {
+                std::cout << ", " << spike.zone << " took " << spike.zoneTime / 1e6
+                          << " ms (median " << spike.zoneMedian / 1e6 << " ms)";
+            }
+            std::cout << '\n';
+        }
+
+        if (profiler.getIntervalFrameCount() >= 100) {
+            profiler.reportInterval(std::cout);
+        }
+    }
+
+    /**
+     * Main loop of the pipelined mode. The core is only touched while the render thread
+     * is idle, so message handling and presentation never race with the drawing.
+     */
+    void runPipelined() {
+        IRenderer& renderer = m_core->getRenderer();
+        RenderThread renderThread(renderer);
+        bool inFlight = false;
+        int recordIndex = 0;
+
+        m_recorder.setViewBounds(renderer.getViewBounds());
+        if (!m_core->onPreFrame()) return;
+
+        while (m_running) {
+            Profiler::getInstance().beginFrame();
+
+            m_frameClock.updateLap();
+            float dt = std::max(m_frameClock.getDeltaTime(), 0.0f);
+
+            RenderCommandList& commands = m_frames[recordIndex];
+            commands.clear();
+            m_recorder.setTarget(&commands);
+
+            m_recording = true;
+            update(dt);
+            render();
+            m_recording = false;
+
+            if (inFlight) {
+                renderThread.wait();
+                inFlight = false;
+
+                PROFILE_ZONE("onPostFrame");
+                m_core->onPostFrame();
+            }
+
+            {
+                PROFILE_ZONE("onPreFrame");
+                if (!m_core->onPreFrame()) break;
+            }
+
+            m_recorder.setViewBounds(renderer.getViewBounds());
+            renderThread.submit(commands);
+            inFlight = true;
+            recordIndex = 1 - recordIndex;
+
+            // the render thread keeps drawing while the loop waits
+            pace();
+            endFrame();
+            FrameArena::nextFrame();
+        }
+
+        if (inFlight) {
+            renderThread.wait();
+            m_core->onPostFrame();
         }
     }
 
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+/**
+ * Holds a loop to a target frame rate without burning a core.
+ *
+ * wait() sleeps in 1 ms slices while the deadline is further away than a slice has been
+ * observed to take, then spins for the short remainder. The slice estimate (mean plus one
+ * standard deviation of the measured slices) adapts to the OS timer, so the spin stays
+ * short where sleeping is accurate and grows where it isn't.
+ *
+ * Deadlines advance by a fixed period, so a short frame makes up for a long one. A frame
+ * that misses its deadline by more than a whole period restarts the schedule instead of
+ * bursting frames to catch up.
+ */
+class FramePacer {
+private:
+    using clock = std::chrono::steady_clock;
+
+    double period;
+    clock::time_point deadline;
+    clock::time_point lastFrame;
+    bool started = false;
+
+    // running statistics of how long a 1 ms sleep really takes, in seconds (Welford)
+    double sleepEstimate = 0.002;
+    double sleepMean = 0.002;
+    double sleepM2 = 0.0;
+    std::uint64_t sleepCount = 1;
+
+    // pacing statistics
+    std::uint64_t frames = 0;
+    std::uint64_t lateFrames = 0;
+    double frameTimeSum = 0.0;
+    double maxFrameTime = 0.0;
+    double sleptTime = 0.0;
+    double spunTime = 0.0;
+
+    static double seconds(clock::duration duration) {
+        return std::chrono::duration<double>(duration).count();
+    }
+
+    void recordSleep(double observed) {
+        sleepCount++;
+        double delta = observed - sleepMean;
+        sleepMean += delta / static_cast<double>(sleepCount);
+        sleepM2 += delta * (observed - sleepMean);
+        sleepEstimate = sleepMean + std::sqrt(sleepM2 / static_cast<double>(sleepCount - 1));
+    }
+
+public:
+    explicit FramePacer(double framesPerSecond)
+        : period(1.0 / framesPerSecond) {}
+
+    /**
+     * Blocks until the next frame is due. Call once per frame.
+     */
+    void wait() {
+        clock::time_point now = clock::now();
+        if (!started) {
+            started = true;
+            deadline = now;
+            lastFrame = now;
+        }
+
+        deadline += std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(period));
+        if (now > deadline + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(period))) {
+            lateFrames++;
+            deadline = now;
+        }
+
+        while (seconds(deadline - now) > sleepEstimate) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            clock::time_point woken = clock::now();
+            recordSleep(seconds(woken - now));
+            sleptTime += seconds(woken - now);
+            now = woken;
+        }
+
+        clock::time_point spinStart = now;
+        while (now < deadline) {
+            std::this_thread::yield();
+            now = clock::now();
+        }
+        spunTime += seconds(now - spinStart);
+
+        double frameTime = seconds(now - lastFrame);
+        frameTimeSum += frameTime;
+        maxFrameTime = std::max(maxFrameTime, frameTime);
+        frames++;
+        lastFrame = now;
+    }
+
+    double getTargetFrameRate() const {
+        return 1.0 / period;
+    }
+
+    /**
+     * Average rate the frames were actually released at.
+     */
+    double getAchievedFrameRate() const {
+        return (frameTimeSum > 0.0) ? static_cast<double>(frames) / frameTimeSum : 0.0;
+    }
+
+    double getMaxFrameTime() const {
+        return maxFrameTime;
+    }
+
+    /**
+     * Frames that came in more than a whole period late and restarted the schedule.
+     */
+    std::uint64_t getLateFrameCount() const {
+        return lateFrames;
+    }
+
+    std::uint64_t getFrameCount() const {
+        return frames;
+    }
+
+    /**
+     * Share of the paced waiting spent spinning rather than asleep.
+     */
+    double getSpinFraction() const {
+        double waited = sleptTime + spunTime;
+        return (waited > 0.0) ? spunTime / waited : 0.0;
+    }
+};
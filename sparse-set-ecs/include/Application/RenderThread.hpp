@@ -0,0 +1,98 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "IRenderer.hpp"
+#include "Profiler.hpp"
+#include "RenderCommandList.hpp"
+
+/**
+ * Replays recorded frames into a renderer on a thread of its own, so the next frame can be
+ * simulated while the last one is drawn.
+ *
+ * One frame is in flight at a time: submit() hands a list over and returns straight away,
+ * wait() blocks until it has been replayed and flushed. The list and the renderer must not
+ * be touched by anyone else in between.
+ */
+class RenderThread {
+private:
+    IRenderer& renderer;
+
+    std::mutex mutex;
+    std::condition_variable frameSubmitted;
+    std::condition_variable frameDone;
+    const RenderCommandList* pending = nullptr;
+    bool busy = false;
+    bool stopping = false;
+
+    std::thread thread;
+
+    void renderLoop() {
+        Profiler::getInstance().setThreadName("Render");
+
+        while (true) {
+            const RenderCommandList* commands = nullptr;
+            {
+                std::unique_lock lock(mutex);
+                frameSubmitted.wait(lock, [this] { return stopping || pending != nullptr; });
+
+                if (pending == nullptr) return;
+                commands = pending;
+                pending = nullptr;
+            }
+
+            {
+                PROFILE_ZONE("RenderThread::frame");
+                renderer.submit(*commands);
+                renderer.flush();
+            }
+
+            {
+                std::lock_guard lock(mutex);
+                busy = false;
+            }
+            frameDone.notify_one();
+        }
+    }
+
+public:
+    explicit RenderThread(IRenderer& renderer_)
+        : renderer(renderer_), thread(&RenderThread::renderLoop, this) {}
+
+    ~RenderThread() {
+        wait();
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        frameSubmitted.notify_one();
+        thread.join();
+    }
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    /**
+     * Starts drawing commands. The previous frame must have been waited for.
+     */
+    void submit(const RenderCommandList& commands) {
+        {
+            std::lock_guard lock(mutex);
+            pending = &commands;
+            busy = true;
+        }
+        frameSubmitted.notify_one();
+    }
+
+    /**
+     * Blocks until the submitted frame has been drawn, returns at once if there is none.
+     */
+    void wait() {
+        PROFILE_ZONE("RenderThread::wait");
+
+        std::unique_lock lock(mutex);
+        frameDone.wait(lock, [this] { return !busy; });
+    }
+};
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Framebuffer.hpp"
+#include "Profiler.hpp"
+
+/**
+ * Writes finished frames to a file on a background thread.
+ *
+ * submit() copies the frame into a free buffer of a fixed-size ring and returns straight
+ * away; the writer thread encodes and writes the buffers in order. When the writer falls
+ * behind and every buffer is taken, the new frame is dropped and counted instead of
+ * stalling the caller.
+ */
+class FrameCapture {
+public:
+    enum class Format {
+        Raw, // the 0x00RRGGBB pixels as they are, little-endian BGRA bytes
+        Ppm, // one binary PPM image after another
+        Y4m  // YUV4MPEG2 stream, full resolution 4:4:4 BT.601
+    };
+
+private:
+    int width;
+    int height;
+    Format format;
+    std::ofstream file;
+
+    // frames [readIndex, writeIndex) are queued for the writer, indices grow forever and wrap by modulo
+    std::vector<std::vector<std::uint32_t>> ring;
+    std::uint64_t readIndex = 0;
+    std::uint64_t writeIndex = 0;
+
+    std::mutex mutex;
+    std::condition_variable frameQueued;
+    bool stopping = false;
+
+    std::atomic<std::uint64_t> submitted = 0;
+    std::atomic<std::uint64_t> dropped = 0;
+    std::atomic<std::uint64_t> written = 0;
+
+    std::vector<std::uint8_t> encoded;
+    std::thread writer;
+
+    static std::uint8_t toByte(float value) {
+        return static_cast<std::uint8_t>(std::clamp(value + 0.5f, 0.0f, 255.0f));
+    }
+
+    void writeHeader(int framesPerSecond) {
+        if (format == Format::Y4m) {
+            file << "YUV4MPEG2 W" << width << " H" << height << " F" << framesPerSecond << ":1 Ip A1:1 C444\n";
+        }
+    }
+
+    void encode(const std::vector<std::uint32_t>& pixels) {
+        PROFILE_ZONE("FrameCapture::encode");
+
+        std::size_t count = pixels.size();
+        encoded.clear();
+
+        switch (format) {
+            case Format::Raw: {
+                const auto* bytes = reinterpret_cast<const std::uint8_t*>(pixels.data());
+                encoded.assign(bytes, bytes + count * sizeof(std::uint32_t));
+                break;
+            }
+            case Format::Ppm: {
+                std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+                encoded.assign(header.begin(), header.end());
+                encoded.reserve(encoded.size() + count * 3);
+                for (std::uint32_t pixel : pixels) {
+                    encoded.push_back(static_cast<std::uint8_t>(pixel >> 16));
+                    encoded.push_back(static_cast<std::uint8_t>(pixel >> 8));
+                    encoded.push_back(static_cast<std::uint8_t>(pixel));
+                }
+                break;
+            }
+            case Format::Y4m: {
+                static constexpr char FRAME_HEADER[] = "FRAME\n";
+                encoded.assign(FRAME_HEADER, FRAME_HEADER + sizeof(FRAME_HEADER) - 1);
+                std::size_t planes = encoded.size();
+                encoded.resize(planes + count * 3);
+
+                std::uint8_t* y = encoded.data() + planes;
+                std::uint8_t* u = y + count;
+                std::uint8_t* v = u + count;
+                for (std::size_t i = 0; i < count; ++i) {
+                    float r = static_cast<float>((pixels[i] >> 16) & 0xFF);
+                    float g = static_cast<float>((pixels[i] >> 8) & 0xFF);
+                    float b = static_cast<float>(pixels[i] & 0xFF);
+                    y[i] = toByte(16.0f + 0.257f * r + 0.504f * g + 0.098f * b);
+                    u[i] = toByte(128.0f - 0.148f * r - 0.291f * g + 0.439f * b);
+                    v[i] = toByte(128.0f + 0.439f * r - 0.368f * g - 0.071f * b);
+                }
+                break;
+            }
+        }
+
+        file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+    }
+
+    void writerLoop() {
+        Profiler::getInstance().setThreadName("Capture writer");
+
+        while (true) {
+            std::vector<std::uint32_t>* frame = nullptr;
+            {
+                std::unique_lock lock(mutex);
+                frameQueued.wait(lock, [this] { return stopping || readIndex != writeIndex; });
+
+                // queued frames are still written when stopping
+                if (readIndex == writeIndex) return;
+                frame = &ring[readIndex % ring.size()];
+            }
+
+            encode(*frame);
+            written.fetch_add(1, std::memory_order_relaxed);
+
+            std::lock_guard lock(mutex);
+            readIndex++;
+        }
+    }
+
+public:
+    /**
+     * @param ringSize number of frames that can wait for the writer before frames are dropped
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    FrameCapture(const std::string& path, Format format_, int width_, int height_, int framesPerSecond = 60, std::size_t ringSize = 8)
+        : width(width_), height(height_), format(format_),
+          file(path, std::ios::binary | std::ios::trunc),
+          ring(std::max<std::size_t>(ringSize, 1), std::vector<std::uint32_t>(static_cast<std::size_t>(width_) * height_))
+    {
+        if (!file) {
+            throw std::runtime_error("Failed to open capture file " + path);
+        }
+
+        writeHeader(framesPerSecond);
+        writer = std::thread(&FrameCapture::writerLoop, this);
+    }
+
+    /**
+     * Picks the format from the file extension: .ppm, .y4m, anything else is raw.
+     */
+    static Format formatFor(const std::string& path) {
+        auto endsWith = [&](const std::string& extension) {
+            return path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+        };
+
+        if (endsWith(".ppm")) return Format::Ppm;
+        if (endsWith(".y4m")) return Format::Y4m;
+        return Format::Raw;
+    }
+
+    ~FrameCapture() {
+        close();
+    }
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    /**
+     * Queues a copy of the framebuffer's pixels. Call after Framebuffer::flush().
+     * @return false if the frame was dropped, because the ring is full or the size changed since the capture started
+     */
+    bool submit(const Framebuffer& framebuffer) {
+        submitted.fetch_add(1, std::memory_order_relaxed);
+
+        if (framebuffer.getWidth() != width || framebuffer.getHeight() != height) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        std::vector<std::uint32_t>* slot = nullptr;
+        {
+            std::lock_guard lock(mutex);
+            if (stopping || writeIndex - readIndex == ring.size()) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            slot = &ring[writeIndex % ring.size()];
+        }
+
+        // the writer never touches the slot past writeIndex, so the copy can happen unlocked
+        const auto& pixels = framebuffer.getPixels();
+        std::copy(pixels.begin(), pixels.end(), slot->begin());
+
+        {
+            std::lock_guard lock(mutex);
+            writeIndex++;
+        }
+        frameQueued.notify_one();
+
+        return true;
+    }
+
+    /**
+     * Writes the frames still queued and closes the file. Later frames are dropped.
+     */
+    void close() {
+        {
+            std::lock_guard lock(mutex);
+            if (stopping) return;
+            stopping = true;
+        }
+        frameQueued.notify_one();
+        writer.join();
+        file.close();
+    }
+
+    std::uint64_t getSubmittedCount() const {
+        return submitted.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t getDroppedCount() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t getWrittenCount() const {
+        return written.load(std::memory_order_relaxed);
+    }
+};
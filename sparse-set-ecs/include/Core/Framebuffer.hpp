@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "Color.hpp"
+#include "TileRasteriser.hpp"
+#include "Profiler.hpp"
+
+/**
+ * A 32-bit 0x00RRGGBB pixel buffer and the rasteriser that draws into it.
+ * Knows nothing about windows, so it can be presented by any core or none at all.
+ *
+ * Draw calls are queued and only reach the pixels on flush().
+ */
+class Framebuffer {
+private:
+    int width;
+    int height;
+    std::vector<std::uint32_t> pixels;
+    TileRasteriser rasteriser;
+
+public:
+    Framebuffer(int width_, int height_)
+        : width(width_), height(height_),
+          pixels(width_ * height_, 0),
+          rasteriser(width_, height_) {}
+
+    static std::uint32_t pack(Color color) {
+        return (static_cast<std::uint32_t>(color.r) << 16) | (static_cast<std::uint32_t>(color.g) << 8) | color.b;
+    }
+
+    void resize(int newWidth, int newHeight) {
+        if (newWidth <= 0 || newHeight <= 0) return;
+
+        width = newWidth;
+        height = newHeight;
+
+        pixels.resize(width * height, 0);
+        rasteriser.resize(width, height);
+    }
+
+    int getWidth() const {
+        return width;
+    }
+
+    int getHeight() const {
+        return height;
+    }
+
+    /**
+     * Row-major, width * height pixels.
+     * @note draws still waiting for flush() are not in the buffer yet
+     */
+    const std::vector<std::uint32_t>& getPixels() const {
+        return pixels;
+    }
+
+    /**
+     * Clear the whole buffer with a single color
+     */
+    void clearScreen(Color color) {
+        rasteriser.clear(pack(color));
+    }
+
+    /**
+     * Change a single pixels color
+     */
+    void drawPixel(int x, int y, Color color) {
+        rasteriser.addRectangle(x, y, x, y, pack(color));
+    }
+
+    void drawCircle(int centerX, int centerY, float radius, Color color) {
+        rasteriser.addCircle(centerX, centerY, radius, pack(color));
+    }
+
+    /**
+     * @note rectangle edges alligned with screen edges
+     */
+    void drawRectangle(int x1, int x2, int y1, int y2, Color color) {
+        assert(x1 != x2 && y1 != y2);
+
+        rasteriser.addRectangle(x1, y1, x2, y2, pack(color));
+    }
+
+    /**
+     * Bresenham's line from (x1, y1) up to but not including (x2, y2)
+     */
+    void drawLine(int x1, int y1, int x2, int y2, Color color) {
+        rasteriser.addLine(x1, y1, x2, y2, pack(color));
+    }
+
+    /**
+     * Rasterises the draws made since the last flush into the pixels, spread over
+     * the thread pool one screen tile at a time
+     */
+    void flush() {
+        PROFILE_ZONE("Framebuffer::flush");
+
+        rasteriser.flush(pixels.data());
+    }
+};
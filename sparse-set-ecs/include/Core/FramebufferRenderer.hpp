@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include "Color.hpp"
+#include "Framebuffer.hpp"
+#include "IRenderer.hpp"
+#include "Vector2.hpp"
+#include "Vector2x8.hpp"
+
+/**
+ * IRenderer over a Framebuffer. Maps the camera space onto the largest centered area of
+ * the framebuffer with the same aspect ratio and fills the rest with the blanking color.
+ */
+class FramebufferRenderer final : public IRenderer {
+private:
+    Framebuffer* m_framebuffer = nullptr;
+
+    float m_top = 1.0f; 
+    float m_bottom = -1.0f; 
+    float m_left = -1.0f; 
+    float m_right = 1.0f;
+   
+    float m_cameraAspectRatio = (m_right - m_left) / (m_top - m_bottom);
+
+    // cached camera to pixel transform, pixel = camera * m_pixelScale + m_pixelOffset
+    Vector2 m_pixelScale{1.0f, 1.0f};
+    Vector2 m_pixelOffset{0.0f, 0.0f};
+    int m_transformWidth = -1;
+    int m_transformHeight = -1;
+
+    // scratch space for the pixel positions of a batch
+    std::vector<Vector2> m_pixelPoints1;
+    std::vector<Vector2> m_pixelPoints2;
+
+    Vector2 calculateAdjustedWindowSize() {
+        float width = m_framebuffer->getWidth();
+        float height = m_framebuffer->getHeight();
+        float windowAspectRatio = width / height; 
+
+        float adjustedWindowWidth = width;
+        float adjustedWindowHeight = height;
+
+        if (windowAspectRatio > m_cameraAspectRatio) {
+            // window too wide
+            adjustedWindowWidth = height * m_cameraAspectRatio;
+        } else if (windowAspectRatio < m_cameraAspectRatio) {
+            // window too tall 
+            adjustedWindowHeight = width / m_cameraAspectRatio; 
+        }
+
+        return Vector2{adjustedWindowWidth, adjustedWindowHeight};
+    }
+
+    // recomputes the transform only when the framebuffer was resized or the camera changed
+    void updateTransform() {
+        assert(m_framebuffer != nullptr);
+
+        int width = m_framebuffer->getWidth();
+        int height = m_framebuffer->getHeight();
+
+        if (width == m_transformWidth && height == m_transformHeight) {
+            return;
+        }
+
+        Vector2 adjustedWindowSize = calculateAdjustedWindowSize();
+        Vector2 windowOffset = (Vector2{static_cast<float>(width), static_cast<float>(height)} - adjustedWindowSize) / 2.0f;
+
+        m_pixelScale = Vector2{
+            adjustedWindowSize.x / (m_right - m_left),
+            -adjustedWindowSize.y / (m_top - m_bottom)
+        };
+        m_pixelOffset = -m_pixelScale * Vector2(m_left, m_top) + windowOffset;
+
+        m_transformWidth = width;
+        m_transformHeight = height;
+    }
+
+    Vector2 convertToPixelSpace(Vector2 cameraSpace) {
+        updateTransform();
+
+        return m_pixelScale * cameraSpace + m_pixelOffset;
+    }
+
+    void convertToPixelSpace(std::span<const Vector2> cameraSpace, std::vector<Vector2>& pixelSpace) {
+        updateTransform();
+
+        pixelSpace.resize(cameraSpace.size());
+        VectorBatch::transform(cameraSpace.data(), cameraSpace.size(), m_pixelScale, m_pixelOffset, pixelSpace.data());
+    }
+
+public:
+    FramebufferRenderer() = default;
+
+    /**
+     * @param framebuffer drawn into until replaced, must outlive the renderer's use
+     */
+    void setFramebuffer(Framebuffer* framebuffer) {
+        m_framebuffer = framebuffer;
+        m_transformWidth = -1;
+    }
+
+    void setCameraSpace(float top, float bottom, float left, float right) override {
+        assert(m_framebuffer != nullptr);
+        
+        assert(top != bottom);
+        assert(right != left);
+
+        m_top = top;
+        m_bottom = bottom;
+        m_left = left;
+        m_right = right;
+
+        m_cameraAspectRatio = (m_right - m_left) / (m_top - m_bottom);
+        m_transformWidth = -1;
+    }
+
+    /**
+     * The camera space rectangle given to setCameraSpace.
+     */
+    ViewBounds getViewBounds() override {
+        updateTransform();
+
+        return ViewBounds{
+            Vector2{std::min(m_left, m_right), std::min(m_bottom, m_top)},
+            Vector2{std::max(m_left, m_right), std::max(m_bottom, m_top)},
+            1.0f / std::abs(m_pixelScale.x)
+        };
+    }
+
+    void clearScreen(Color color) override {
+        clearScreen(color, Color{0, 0, 0});
+    }
+
+    void clearScreen(Color color, Color blankingColor) override {
+        assert(m_framebuffer != nullptr);
+
+        m_framebuffer->clearScreen(blankingColor);
+
+        float height = m_framebuffer->getHeight();
+        float width = m_framebuffer->getWidth();
+        
+        Vector2 adjustedWindowSize = calculateAdjustedWindowSize();
+
+        float widthOffset = (width - adjustedWindowSize.x) / 2.0f;
+        float heightOffset = (height - adjustedWindowSize.y) / 2.0f;
+
+        m_framebuffer->drawRectangle(
+            widthOffset, width - widthOffset,
+            heightOffset, height - heightOffset,
+            color
+        );
+    }
+   
+    void drawCircle(Vector2 center, float radius, Color color) override {
+        assert(m_framebuffer != nullptr);
+
+        Vector2 pixelSpace = convertToPixelSpace(center);
+
+        m_framebuffer->drawCircle(
+            static_cast<int>(pixelSpace.x),
+            static_cast<int>(pixelSpace.y),
+            radius, color
+        ); 
+    }
+
+    void drawRectangle(Vector2 p1, Vector2 p2, Color color) override {
+        assert(m_framebuffer != nullptr);
+
+        Vector2 pixelP1 = convertToPixelSpace(p1);
+        Vector2 pixelP2 = convertToPixelSpace(p2);
+
+        m_framebuffer->drawRectangle(
+            pixelP1.x, pixelP2.x,
+            pixelP1.y, pixelP2.y, 
+            color
+        );
+    }
+
+    void drawLine(Vector2 p1, Vector2 p2, Color color) override {
+        assert(m_framebuffer != nullptr);
+
+        Vector2 pixelP1 = convertToPixelSpace(p1);
+        Vector2 pixelP2 = convertToPixelSpace(p2);
+
+        m_framebuffer->drawLine(pixelP1.x, pixelP1.y, pixelP2.x, pixelP2.y, color);
+    }
+
+    /**
+     * Rasterises everything drawn since the last flush into the framebuffer.
+     */
+    void flush() override {
+        assert(m_framebuffer != nullptr);
+
+        m_framebuffer->flush();
+    }
+
+    void drawCircles(std::span<const Vector2> centers, std::span<const float> radii, std::span<const Color> colors) override {
+        assert(m_framebuffer != nullptr);
+
+        convertToPixelSpace(centers, m_pixelPoints1);
+
+        for (std::size_t i = 0; i < m_pixelPoints1.size(); ++i) {
+            m_framebuffer->drawCircle(
+                static_cast<int>(m_pixelPoints1[i].x),
+                static_cast<int>(m_pixelPoints1[i].y),
+                radii[i], colors[i]
+            );
+        }
+    }
+
+    void drawRectangles(std::span<const Vector2> p1s, std::span<const Vector2> p2s, std::span<const Color> colors) override {
+        assert(m_framebuffer != nullptr);
+
+        convertToPixelSpace(p1s, m_pixelPoints1);
+        convertToPixelSpace(p2s, m_pixelPoints2);
+
+        for (std::size_t i = 0; i < m_pixelPoints1.size(); ++i) {
+            m_framebuffer->drawRectangle(
+                m_pixelPoints1[i].x, m_pixelPoints2[i].x,
+                m_pixelPoints1[i].y, m_pixelPoints2[i].y,
+                colors[i]
+            );
+        }
+    }
+
+    void drawLines(std::span<const Vector2> p1s, std::span<const Vector2> p2s, std::span<const Color> colors) override {
+        assert(m_framebuffer != nullptr);
+
+        convertToPixelSpace(p1s, m_pixelPoints1);
+        convertToPixelSpace(p2s, m_pixelPoints2);
+
+        for (std::size_t i = 0; i < m_pixelPoints1.size(); ++i) {
+            m_framebuffer->drawLine(
+                m_pixelPoints1[i].x, m_pixelPoints1[i].y,
+                m_pixelPoints2[i].x, m_pixelPoints2[i].y,
+                colors[i]
+            );
+        }
+    }
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "ICore.hpp"
+#include "FrameCapture.hpp"
+#include "Framebuffer.hpp"
+#include "FramebufferRenderer.hpp"
+
+/**
+ * Core without a window or any OS dependency. Frames are rasterised into an in-memory
+ * framebuffer and never presented, so the full application loop, rendering included,
+ * can be run and profiled on machines without a display.
+ */
+class HeadlessCore final : public ICore {
+private:
+    Framebuffer m_framebuffer;
+    FramebufferRenderer m_renderer;
+    std::unique_ptr<FrameCapture> m_capture;
+
+    std::uint64_t m_frameLimit;
+    std::uint64_t m_frameCount = 0;
+
+public:
+    /**
+     * @param frameLimit number of frames to run before stopping, 0 runs until the application stops
+     */
+    explicit HeadlessCore(int width = 800, int height = 600, std::uint64_t frameLimit = 0)
+        : m_framebuffer(width, height), m_frameLimit(frameLimit) {}
+
+    HeadlessCore(const HeadlessCore&) = delete;
+    HeadlessCore& operator=(const HeadlessCore&) = delete;
+
+    bool initialize() override {
+        m_renderer.setFramebuffer(&m_framebuffer);
+        return true;
+    }
+
+    void shutdown() override {
+        stopCapture();
+        std::cout << "Ending program after " << m_frameCount << " frames" << std::endl;
+    }
+
+    bool onPreFrame() override {
+        return m_frameLimit == 0 || m_frameCount < m_frameLimit;
+    }
+
+    void onPostFrame() override {
+        m_framebuffer.flush();
+
+        if (m_capture) {
+            m_capture->submit(m_framebuffer);
+        }
+
+        m_frameCount++;
+    }
+
+    IRenderer& getRenderer() override {
+        return m_renderer;
+    }
+
+    /**
+     * Writes every following frame to path on a background thread, in the format its
+     * extension names. Frames are dropped rather than waited for if the disk can't keep up.
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    void startCapture(const std::string& path, int framesPerSecond = 60) {
+        m_capture = std::make_unique<FrameCapture>(
+            path, FrameCapture::formatFor(path),
+            m_framebuffer.getWidth(), m_framebuffer.getHeight(), framesPerSecond
+        );
+    }
+
+    void stopCapture() {
+        if (!m_capture) return;
+
+        m_capture->close();
+        std::cout << "Captured " << m_capture->getWrittenCount() << " frames, dropped "
+                  << m_capture->getDroppedCount() << std::endl;
+        m_capture.reset();
+    }
+
+    const Framebuffer& getFramebuffer() const {
+        return m_framebuffer;
+    }
+
+    std::uint64_t getFrameCount() const {
+        return m_frameCount;
+    }
+};
@@ -1,15 +1,110 @@
 #pragma once
 
+#include <cassert>
+#include <span>
+
 #include "Color.hpp"
+#include "RenderCommandList.hpp"
 #include "Vector2.hpp"
+#include "ViewBounds.hpp"
+#include "Profiler.hpp"
 
 struct IRenderer {
     virtual ~IRenderer() = default;
 
     virtual void setCameraSpace(float top, float bottom, float left, float right) = 0;
+    virtual ViewBounds getViewBounds() = 0;
     virtual void clearScreen(Color color) = 0;
     virtual void clearScreen(Color color, Color blankingColor) = 0;
     virtual void drawCircle(Vector2 center, float radius, Color color) = 0; 
     virtual void drawRectangle(Vector2 p1, Vector2 p2, Color color) = 0;
     virtual void drawLine(Vector2 p1, Vector2 p2, Color color) = 0; 
+
+    /**
+     * Batch versions of the draw calls, element i of each span describes one primitive.
+     * The defaults fall back to the single calls; renderers override them to transform
+     * the whole batch at once.
+     */
+    virtual void drawCircles(std::span<const Vector2> centers, std::span<const float> radii, std::span<const Color> colors) {
+        assert(centers.size() == radii.size() && centers.size() == colors.size());
+        for (std::size_t i = 0; i < centers.size(); ++i) {
+            drawCircle(centers[i], radii[i], colors[i]);
+        }
+    }
+
+    virtual void drawRectangles(std::span<const Vector2> p1s, std::span<const Vector2> p2s, std::span<const Color> colors) {
+        assert(p1s.size() == p2s.size() && p1s.size() == colors.size());
+        for (std::size_t i = 0; i < p1s.size(); ++i) {
+            drawRectangle(p1s[i], p2s[i], colors[i]);
+        }
+    }
+
+    virtual void drawLines(std::span<const Vector2> p1s, std::span<const Vector2> p2s, std::span<const Color> colors) {
+        assert(p1s.size() == p2s.size() && p1s.size() == colors.size());
+        for (std::size_t i = 0; i < p1s.size(); ++i) {
+            drawLine(p1s[i], p2s[i], colors[i]);
+        }
+    }
+
+    /**
+     * Replays the list in recording order, one batch call per run of the same primitive.
+     */
+    virtual void submit(const RenderCommandList& commands) {
+        PROFILE_ZONE("IRenderer::submit");
+
+        for (const auto& batch : commands.getBatches()) {
+            switch (batch.primitive) {
+                case RenderCommandList::Primitive::Circle: {
+                    const auto& circles = commands.getCircles();
+                    drawCircles(
+                        std::span(circles.centers).subspan(batch.begin, batch.count),
+                        std::span(circles.radii).subspan(batch.begin, batch.count),
+                        std::span(circles.colors).subspan(batch.begin, batch.count)
+                    );
+                    break;
+                }
+                case RenderCommandList::Primitive::Rectangle: {
+                    const auto& rectangles = commands.getRectangles();
+                    drawRectangles(
+                        std::span(rectangles.p1s).subspan(batch.begin, batch.count),
+                        std::span(rectangles.p2s).subspan(batch.begin, batch.count),
+                        std::span(rectangles.colors).subspan(batch.begin, batch.count)
+                    );
+                    break;
+                }
+                case RenderCommandList::Primitive::Line: {
+                    const auto& lines = commands.getLines();
+                    drawLines(
+                        std::span(lines.p1s).subspan(batch.begin, batch.count),
+                        std::span(lines.p2s).subspan(batch.begin, batch.count),
+                        std::span(lines.colors).subspan(batch.begin, batch.count)
+                    );
+                    break;
+                }
+                case RenderCommandList::Primitive::Clear: {
+                    for (std::size_t i = batch.begin; i < batch.begin + batch.count; ++i) {
+                        const auto& clear = commands.getClears()[i];
+                        if (clear.hasBlankingColor) {
+                            clearScreen(clear.color, clear.blankingColor);
+                        } else {
+                            clearScreen(clear.color);
+                        }
+                    }
+                    break;
+                }
+                case RenderCommandList::Primitive::Camera: {
+                    for (std::size_t i = batch.begin; i < batch.begin + batch.count; ++i) {
+                        const auto& camera = commands.getCameras()[i];
+                        setCameraSpace(camera.top, camera.bottom, camera.left, camera.right);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * Finishes the draws issued so far. Renderers that draw straight away have nothing to do.
+     */
+    virtual void flush() {}
 };
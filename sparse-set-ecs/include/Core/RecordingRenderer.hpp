@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cassert>
+#include <span>
+
+#include "IRenderer.hpp"
+#include "RenderCommandList.hpp"
+#include "ViewBounds.hpp"
+
+/**
+ * IRenderer that draws nothing and records every call into a RenderCommandList instead,
+ * so the frame can be replayed into a real renderer later with IRenderer::submit().
+ *
+ * getViewBounds() answers from a copy set with setViewBounds(), so recording never touches
+ * the real renderer while it may be busy on another thread. A camera change recorded this
+ * frame is not reflected until the copy is refreshed.
+ */
+class RecordingRenderer final : public IRenderer {
+private:
+    RenderCommandList* m_target = nullptr;
+    ViewBounds m_viewBounds{Vector2{-1.0f, -1.0f}, Vector2{1.0f, 1.0f}, 1.0f};
+
+public:
+    /**
+     * @param target the list following calls are recorded into, must outlive the recording
+     */
+    void setTarget(RenderCommandList* target) {
+        m_target = target;
+    }
+
+    void setViewBounds(const ViewBounds& viewBounds) {
+        m_viewBounds = viewBounds;
+    }
+
+    ViewBounds getViewBounds() override {
+        return m_viewBounds;
+    }
+
+    void setCameraSpace(float top, float bottom, float left, float right) override {
+        assert(m_target != nullptr);
+        m_target->addCameraSpace(top, bottom, left, right);
+    }
+
+    void clearScreen(Color color) override {
+        assert(m_target != nullptr);
+        m_target->addClear(color);
+    }
+
+    void clearScreen(Color color, Color blankingColor) override {
+        assert(m_target != nullptr);
+        m_target->addClear(color, blankingColor);
+    }
+
+    void drawCircle(Vector2 center, float radius, Color color) override {
+        assert(m_target != nullptr);
+        m_target->addCircle(center, radius, color);
+    }
+
+    void drawRectangle(Vector2 p1, Vector2 p2, Color color) override {
+        assert(m_target != nullptr);
+        m_target->addRectangle(p1, p2, color);
+    }
+
+    void drawLine(Vector2 p1, Vector2 p2, Color color) override {
+        assert(m_target != nullptr);
+        m_target->addLine(p1, p2, color);
+    }
+
+    void submit(const RenderCommandList& commands) override {
+        assert(m_target != nullptr);
+        m_target->append(commands);
+    }
+};
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Color.hpp"
+#include "Vector2.hpp"
+
+/**
+ * Draw calls recorded over a frame and replayed in one go with IRenderer::submit().
+ *
+ * Each kind of primitive is kept in its own parallel arrays so the renderer can transform
+ * and draw it in bulk. Consecutive primitives of the same kind are grouped into a batch,
+ * and batches are replayed in recording order, so overlapping shapes still layer the same
+ * way as with individual draw calls.
+ *
+ * Screen clears and camera changes can be recorded too, so a whole frame can be captured
+ * and replayed later, e.g. on another thread.
+ */
+class RenderCommandList {
+public:
+    enum class Primitive { Circle, Rectangle, Line, Clear, Camera };
+
+    struct Batch {
+        Primitive primitive;
+        std::size_t begin;
+        std::size_t count;
+    };
+
+    struct Circles {
+        std::vector<Vector2> centers;
+        std::vector<float> radii;
+        std::vector<Color> colors;
+    };
+
+    // rectangles are stored as two opposite corners, lines as their two end points
+    struct Segments {
+        std::vector<Vector2> p1s;
+        std::vector<Vector2> p2s;
+        std::vector<Color> colors;
+    };
+
+    struct Clear {
+        Color color;
+        Color blankingColor;
+        bool hasBlankingColor;
+    };
+
+    struct Camera {
+        float top, bottom, left, right;
+    };
+
+private:
+    std::vector<Batch> batches;
+    Circles circles;
+    Segments rectangles;
+    Segments lines;
+    std::vector<Clear> clears;
+    std::vector<Camera> cameras;
+
+    template<typename T>
+    static void appendTo(std::vector<T>& to, const std::vector<T>& from) {
+        to.insert(to.end(), from.begin(), from.end());
+    }
+
+    std::size_t countOf(Primitive primitive) const {
+        switch (primitive) {
+            case Primitive::Circle: return circles.centers.size();
+            case Primitive::Rectangle: return rectangles.p1s.size();
+            case Primitive::Line: return lines.p1s.size();
+            case Primitive::Clear: return clears.size();
+            case Primitive::Camera: return cameras.size();
+        }
+        return 0;
+    }
+
+    void extend(Primitive primitive, std::size_t index) {
+        if (!batches.empty() && batches.back().primitive == primitive) {
+            batches.back().count++;
+        } else {
+            batches.push_back(Batch{primitive, index, 1});
+        }
+    }
+
+public:
+    /**
+     * Empties the list but keeps its storage, so recording the next frame does not allocate.
+     */
+    void clear() {
+        batches.clear();
+        circles.centers.clear();
+        circles.radii.clear();
+        circles.colors.clear();
+        rectangles.p1s.clear();
+        rectangles.p2s.clear();
+        rectangles.colors.clear();
+        lines.p1s.clear();
+        lines.p2s.clear();
+        lines.colors.clear();
+        clears.clear();
+        cameras.clear();
+    }
+
+    /**
+     * Records everything in other after what is already in the list.
+     */
+    void append(const RenderCommandList& other) {
+        for (const Batch& batch : other.batches) {
+            std::size_t begin = countOf(batch.primitive) + batch.begin;
+
+            if (!batches.empty() && batches.back().primitive == batch.primitive
+                && batches.back().begin + batches.back().count == begin) {
+                batches.back().count += batch.count;
+            } else {
+                batches.push_back(Batch{batch.primitive, begin, batch.count});
+            }
+        }
+
+        appendTo(circles.centers, other.circles.centers);
+        appendTo(circles.radii, other.circles.radii);
+        appendTo(circles.colors, other.circles.colors);
+        appendTo(rectangles.p1s, other.rectangles.p1s);
+        appendTo(rectangles.p2s, other.rectangles.p2s);
+        appendTo(rectangles.colors, other.rectangles.colors);
+        appendTo(lines.p1s, other.lines.p1s);
+        appendTo(lines.p2s, other.lines.p2s);
+        appendTo(lines.colors, other.lines.colors);
+        appendTo(clears, other.clears);
+        appendTo(cameras, other.cameras);
+    }
+
+    void addCircle(Vector2 center, float radius, Color color) {
+        extend(Primitive::Circle, circles.centers.size());
+        circles.centers.push_back(center);
+        circles.radii.push_back(radius);
+        circles.colors.push_back(color);
+    }
+
+    void addRectangle(Vector2 p1, Vector2 p2, Color color) {
+        extend(Primitive::Rectangle, rectangles.p1s.size());
+        rectangles.p1s.push_back(p1);
+        rectangles.p2s.push_back(p2);
+        rectangles.colors.push_back(color);
+    }
+
+    void addLine(Vector2 p1, Vector2 p2, Color color) {
+        extend(Primitive::Line, lines.p1s.size());
+        lines.p1s.push_back(p1);
+        lines.p2s.push_back(p2);
+        lines.colors.push_back(color);
+    }
+
+    void addClear(Color color) {
+        extend(Primitive::Clear, clears.size());
+        clears.push_back(Clear{color, Color{}, false});
+    }
+
+    void addClear(Color color, Color blankingColor) {
+        extend(Primitive::Clear, clears.size());
+        clears.push_back(Clear{color, blankingColor, true});
+    }
+
+    void addCameraSpace(float top, float bottom, float left, float right) {
+        extend(Primitive::Camera, cameras.size());
+        cameras.push_back(Camera{top, bottom, left, right});
+    }
+
+    const std::vector<Batch>& getBatches() const {
+        return batches;
+    }
+
+    const Circles& getCircles() const {
+        return circles;
+    }
+
+    const Segments& getRectangles() const {
+        return rectangles;
+    }
+
+    const Segments& getLines() const {
+        return lines;
+    }
+
+    const std::vector<Clear>& getClears() const {
+        return clears;
+    }
+
+    const std::vector<Camera>& getCameras() const {
+        return cameras;
+    }
+
+    /**
+     * Number of shapes recorded, clears and camera changes not included.
+     */
+    std::size_t getSize() const {
+        return circles.centers.size() + rectangles.p1s.size() + lines.p1s.size();
+    }
+};
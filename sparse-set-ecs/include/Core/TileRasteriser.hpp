@@ -0,0 +1,345 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define TILE_RASTERISER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define TILE_RASTERISER_SSE2
+#endif
+
+#include "Profiler.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * Binning software rasteriser for a 32-bit pixel buffer.
+ *
+ * Draw calls are recorded over a frame and binned into TILE_SIZE x TILE_SIZE screen tiles
+ * by their bounding box. flush() then rasterises the tiles in parallel. Each tile draws its
+ * commands in recording order, clipped to its own rectangle. No two threads ever write the
+ * same pixel, and the result is the same as drawing the commands one at a time.
+ */
+class TileRasteriser {
+public:
+    static constexpr int TILE_SIZE = 64;
+
+private:
+    enum class Shape : std::uint8_t { Circle, Rectangle, Line };
+
+    struct Command {
+        Shape shape;
+        std::uint32_t pixel;
+        int x1, y1, x2, y2; // bounding box for circles and rectangles, end points for lines
+        int centerX, centerY;
+        float radius;
+    };
+
+    struct Tile {
+        int minX, minY, maxX, maxY; // inclusive pixel bounds
+        std::vector<std::uint32_t> commands;
+    };
+
+    std::vector<Command> commands;
+    std::vector<Tile> tiles;
+    int width = 0;
+    int height = 0;
+
+    bool hasClear = false;
+    std::uint32_t clearPixel = 0;
+
+    // adds the command to every tile its bounding box touches, commands fully off screen are dropped
+    void record(const Command& command, int minX, int minY, int maxX, int maxY) {
+        minX = std::max(minX, 0);
+        minY = std::max(minY, 0);
+        maxX = std::min(maxX, width - 1);
+        maxY = std::min(maxY, height - 1);
+
+        if (minX > maxX || minY > maxY) {
+            return;
+        }
+
+        std::uint32_t index = static_cast<std::uint32_t>(commands.size());
+        commands.push_back(command);
+
+        int tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+        for (int tileY = minY / TILE_SIZE; tileY <= maxY / TILE_SIZE; ++tileY) {
+            for (int tileX = minX / TILE_SIZE; tileX <= maxX / TILE_SIZE; ++tileX) {
+                tiles[tileY * tilesX + tileX].commands.push_back(index);
+            }
+        }
+    }
+
+    // writes count copies of pixel, eight or four per store where SIMD is available
+    static void fillSpan(std::uint32_t* span, int count, std::uint32_t pixel) {
+#if defined(TILE_RASTERISER_AVX2)
+        __m256i packed = _mm256_set1_epi32(static_cast<int>(pixel));
+        for (; count >= 8; count -= 8, span += 8) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(span), packed);
+        }
+#elif defined(TILE_RASTERISER_SSE2)
+        __m128i packed = _mm_set1_epi32(static_cast<int>(pixel));
+        for (; count >= 4; count -= 4, span += 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(span), packed);
+        }
+#endif
+        for (; count > 0; --count) {
+            *span++ = pixel;
+        }
+    }
+
+    static void fill(std::uint32_t* pixels, int stride, const Tile& tile, int minX, int minY, int maxX, int maxY, std::uint32_t pixel) {
+        minX = std::max(minX, tile.minX);
+        minY = std::max(minY, tile.minY);
+        maxX = std::min(maxX, tile.maxX);
+        maxY = std::min(maxY, tile.maxY);
+
+        if (minX > maxX) {
+            return;
+        }
+
+        for (int y = minY; y <= maxY; ++y) {
+            fillSpan(pixels + y * stride + minX, maxX - minX + 1, pixel);
+        }
+    }
+
+    /**
+     * One span per row, covering the pixels with dx * dx + dy * dy <= radius * radius.
+     * The half width starts from the square root and is nudged by whole pixels until it
+     * agrees with that test, so rounding never adds or loses a pixel at the edge.
+     */
+    static void drawCircle(std::uint32_t* pixels, int stride, const Tile& tile, const Command& command) {
+        int minY = std::max(command.y1, tile.minY);
+        int maxY = std::min(command.y2, tile.maxY);
+        int minX = std::max(command.x1, tile.minX);
+        int maxX = std::min(command.x2, tile.maxX);
+
+        float radiusSquared = command.radius * command.radius;
+        auto inside = [radiusSquared](float dx, float dy) {
+            return dx * dx + dy * dy <= radiusSquared;
+        };
+
+        for (int y = minY; y <= maxY; ++y) {
+            float dy = y - command.centerY;
+            if (!inside(0.0f, dy)) continue;
+
+            int halfWidth = static_cast<int>(std::sqrt(radiusSquared - dy * dy));
+            while (inside(halfWidth + 1, dy)) halfWidth++;
+            while (!inside(halfWidth, dy)) halfWidth--;
+
+            int spanMinX = std::max(minX, command.centerX - halfWidth);
+            int spanMaxX = std::min(maxX, command.centerX + halfWidth);
+
+            if (spanMinX <= spanMaxX) {
+                fillSpan(pixels + y * stride + spanMinX, spanMaxX - spanMinX + 1, command.pixel);
+            }
+        }
+    }
+
+    /**
+     * Bresenham line clipped to the tile before any pixel is visited.
+     *
+     * Step k of the line moves one pixel along its major axis and minorSteps(k) pixels
+     * along the minor one, the same pixels the classic error-term loop visits. Both are
+     * monotonic in k, so the steps inside the tile form one range, found Liang-Barsky style
+     * by solving for the steps at which the line enters and leaves each pair of tile edges.
+     * The loop over that range needs no bounds checks.
+     */
+    static void drawLine(std::uint32_t* pixels, int stride, const Tile& tile, const Command& command) {
+        int dx = std::abs(command.x2 - command.x1);
+        int dy = std::abs(command.y2 - command.y1);
+        int sx = (command.x1 < command.x2) ? 1 : -1;
+        int sy = (command.y1 < command.y2) ? 1 : -1;
+
+        bool xMajor = dx >= dy;
+        std::int64_t major = xMajor ? dx : dy;
+        std::int64_t minor = xMajor ? dy : dx;
+
+        // the end point itself is not drawn
+        if (major == 0) return;
+
+        int majorStart = xMajor ? command.x1 : command.y1;
+        int minorStart = xMajor ? command.y1 : command.x1;
+        int majorSign = xMajor ? sx : sy;
+        int minorSign = xMajor ? sy : sx;
+        int majorMin = xMajor ? tile.minX : tile.minY;
+        int majorMax = xMajor ? tile.maxX : tile.maxY;
+        int minorMin = xMajor ? tile.minY : tile.minX;
+        int minorMax = xMajor ? tile.maxY : tile.maxX;
+
+        // minorSteps(k) = ceil((2k * minor - major) / (2 * major))
+        auto firstStepWithMinor = [&](std::int64_t steps) -> std::int64_t {
+            if (steps <= 0) return 0;
+            if (minor == 0) return major;
+            std::int64_t numerator = 2 * steps * major - major + 1;
+            return (numerator + 2 * minor - 1) / (2 * minor);
+        };
+
+        // steps whose major coordinate is inside the tile
+        std::int64_t first = 0;
+        std::int64_t last = major - 1;
+        std::int64_t toMin = static_cast<std::int64_t>(majorMin - majorStart) * majorSign;
+        std::int64_t toMax = static_cast<std::int64_t>(majorMax - majorStart) * majorSign;
+        first = std::max(first, std::min(toMin, toMax));
+        last = std::min(last, std::max(toMin, toMax));
+
+        // and whose minor coordinate is, minor steps only ever move towards minorSign
+        std::int64_t nearEdge = static_cast<std::int64_t>((minorSign > 0 ? minorMin : minorMax) - minorStart) * minorSign;
+        std::int64_t farEdge = static_cast<std::int64_t>((minorSign > 0 ? minorMax : minorMin) - minorStart) * minorSign;
+        if (farEdge < 0) return;
+        first = std::max(first, firstStepWithMinor(nearEdge));
+        last = std::min(last, firstStepWithMinor(farEdge + 1) - 1);
+
+        if (first > last) return;
+
+        // minorSteps(k) and its remainder, then stepped incrementally
+        std::int64_t twiceMajor = 2 * major;
+        std::int64_t numerator = 2 * first * minor + major - 1;
+        std::int64_t minorSteps = numerator / twiceMajor;
+        std::int64_t remainder = numerator - minorSteps * twiceMajor;
+
+        int majorPos = majorStart + static_cast<int>(first) * majorSign;
+        int minorPos = minorStart + static_cast<int>(minorSteps) * minorSign;
+
+        int majorStride = xMajor ? majorSign : majorSign * stride;
+        int minorStride = xMajor ? minorSign * stride : minorSign;
+        std::uint32_t* pixel = xMajor
+            ? pixels + static_cast<std::ptrdiff_t>(minorPos) * stride + majorPos
+            : pixels + static_cast<std::ptrdiff_t>(majorPos) * stride + minorPos;
+
+        for (std::int64_t k = first; k <= last; ++k) {
+            *pixel = command.pixel;
+            pixel += majorStride;
+
+            remainder += 2 * minor;
+            if (remainder >= twiceMajor) {
+                remainder -= twiceMajor;
+                pixel += minorStride;
+            }
+        }
+    }
+
+    void rasterise(std::uint32_t* pixels, const Tile& tile) const {
+        if (hasClear) {
+            fill(pixels, width, tile, tile.minX, tile.minY, tile.maxX, tile.maxY, clearPixel);
+        }
+
+        for (std::uint32_t index : tile.commands) {
+            const Command& command = commands[index];
+
+            switch (command.shape) {
+                case Shape::Circle:
+                    drawCircle(pixels, width, tile, command);
+                    break;
+                case Shape::Rectangle:
+                    fill(pixels, width, tile, command.x1, command.y1, command.x2, command.y2, command.pixel);
+                    break;
+                case Shape::Line:
+                    drawLine(pixels, width, tile, command);
+                    break;
+            }
+        }
+    }
+
+public:
+    TileRasteriser(int width_, int height_) {
+        resize(width_, height_);
+    }
+
+    /**
+     * Changes the target size. Commands recorded for the old size are discarded.
+     */
+    void resize(int width_, int height_) {
+        width = width_;
+        height = height_;
+
+        commands.clear();
+        hasClear = false;
+        tiles.clear();
+
+        for (int y = 0; y < height; y += TILE_SIZE) {
+            for (int x = 0; x < width; x += TILE_SIZE) {
+                tiles.push_back(Tile{
+                    x, y,
+                    std::min(x + TILE_SIZE, width) - 1,
+                    std::min(y + TILE_SIZE, height) - 1,
+                    {}
+                });
+            }
+        }
+    }
+
+    /**
+     * Fills the whole target. Everything recorded before it would be overdrawn, so it is dropped.
+     */
+    void clear(std::uint32_t pixel) {
+        commands.clear();
+        for (auto& tile : tiles) {
+            tile.commands.clear();
+        }
+
+        hasClear = true;
+        clearPixel = pixel;
+    }
+
+    /**
+     * Pixels within radius of the center, inside the bounding box truncated to whole pixels.
+     */
+    void addCircle(int centerX, int centerY, float radius, std::uint32_t pixel) {
+        int minX = centerX - radius;
+        int minY = centerY - radius;
+        int maxX = centerX + radius;
+        int maxY = centerY + radius;
+
+        record(Command{Shape::Circle, pixel, minX, minY, maxX, maxY, centerX, centerY, radius}, minX, minY, maxX, maxY);
+    }
+
+    /**
+     * Axis aligned rectangle including both corners, in any order.
+     */
+    void addRectangle(int x1, int y1, int x2, int y2, std::uint32_t pixel) {
+        if (x2 < x1) std::swap(x1, x2);
+        if (y2 < y1) std::swap(y1, y2);
+
+        record(Command{Shape::Rectangle, pixel, x1, y1, x2, y2, 0, 0, 0.0f}, x1, y1, x2, y2);
+    }
+
+    /**
+     * Line from (x1, y1) up to but not including (x2, y2).
+     */
+    void addLine(int x1, int y1, int x2, int y2, std::uint32_t pixel) {
+        record(
+            Command{Shape::Line, pixel, x1, y1, x2, y2, 0, 0, 0.0f},
+            std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2)
+        );
+    }
+
+    /**
+     * Rasterises everything recorded since the last flush into pixels, a width * height
+     * row-major buffer, and starts a new empty frame.
+     */
+    void flush(std::uint32_t* pixels) {
+        if (commands.empty() && !hasClear) {
+            return;
+        }
+
+        ThreadPool::getInstance().parallelFor(tiles.size(), [&](std::size_t begin, std::size_t end) {
+            PROFILE_ZONE("TileRasteriser::rasterise");
+
+            for (std::size_t i = begin; i < end; ++i) {
+                rasterise(pixels, tiles[i]);
+            }
+        });
+
+        commands.clear();
+        for (auto& tile : tiles) {
+            tile.commands.clear();
+        }
+        hasClear = false;
+    }
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+
+#include "Vector2.hpp"
+
+/**
+ * The rectangle of camera space a renderer currently shows, used to skip drawing
+ * what would land off screen.
+ */
+struct ViewBounds {
+    Vector2 min;
+    Vector2 max;
+    float unitsPerPixel; // camera space distance covered by one pixel
+
+    /**
+     * Grows the bounds on every side by a camera space margin plus a pixel margin,
+     * e.g. the longest line drawn from a point plus the largest circle radius.
+     */
+    ViewBounds expanded(float margin, float pixelMargin = 0.0f) const {
+        float total = margin + pixelMargin * unitsPerPixel;
+        return ViewBounds{
+            Vector2{min.x - total, min.y - total},
+            Vector2{max.x + total, max.y + total},
+            unitsPerPixel
+        };
+    }
+
+    bool contains(const Vector2& point) const {
+        return point.x > min.x && point.x < max.x && point.y > min.y && point.y < max.y;
+    }
+
+    /**
+     * @param pixelRadius radius as given to IRenderer::drawCircle, which is in pixels
+     */
+    bool overlapsCircle(const Vector2& center, float pixelRadius) const {
+        float radius = pixelRadius * unitsPerPixel;
+        float dx = center.x - std::clamp(center.x, min.x, max.x);
+        float dy = center.y - std::clamp(center.y, min.y, max.y);
+        return dx * dx + dy * dy <= radius * radius;
+    }
+
+    /**
+     * Conservative: true for segments whose bounding box touches the view.
+     */
+    bool overlapsLine(const Vector2& p1, const Vector2& p2) const {
+        return std::max(p1.x, p2.x) >= min.x && std::min(p1.x, p2.x) <= max.x
+            && std::max(p1.y, p2.y) >= min.y && std::min(p1.y, p2.y) <= max.y;
+    }
+};
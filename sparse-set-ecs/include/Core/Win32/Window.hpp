@@ -8,7 +8,8 @@
 #include <cmath>
 #include <cstring>
 
-#include "Color.hpp"
+#include "Framebuffer.hpp"
+#include "Profiler.hpp"
 
 class Window {
 private:
@@ -17,7 +18,7 @@ private:
     int width;
     int height;
     const std::string class_name;
-    std::vector<uint32_t> pixelBuffer;
+    Framebuffer framebuffer;
 
     // cached bitmap resources
     HBITMAP hCachedBitmap;
@@ -62,7 +63,7 @@ private:
         width = newWidth;
         height = newHeight;
 
-        pixelBuffer.resize(width * height, 0);
+        framebuffer.resize(width, height);
     }
 
     static LRESULT CALLBACK WindowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
@@ -92,10 +93,8 @@ private:
 
                 if (window->hCachedBitmap && window->pBitmapBits) {
                     // copy pixel buffer to bitmap memory
-                    std::memcpy(
-                        window->pBitmapBits, window->pixelBuffer.data(),
-                        window->pixelBuffer.size() * sizeof(uint32_t)
-                    );
+                    const auto& pixels = window->framebuffer.getPixels();
+                    std::memcpy(window->pBitmapBits, pixels.data(), pixels.size() * sizeof(uint32_t));
 
                     // Blit from cached DC to screen
                     BitBlt(hdc, 0, 0, window->width, window->height, window->hCachedDC, 0, 0, SRCCOPY);
@@ -132,7 +131,7 @@ public:
         : width(w), height(h), 
           hInstance(GetModuleHandle(nullptr)),
           class_name(title + "Class"),
-          pixelBuffer(w * h, 0),
+          framebuffer(w, h),
           hCachedBitmap(nullptr),
           hCachedDC(nullptr),
           pBitmapBits(nullptr)
@@ -207,8 +206,8 @@ public:
         return true;
     }
    
-    std::vector<uint32_t>& getPixelBuffer() {
-        return pixelBuffer;
+    Framebuffer& getFramebuffer() {
+        return framebuffer;
     }
 
     int getWidth() const {
@@ -219,98 +218,14 @@ public:
         return height;
     }
 
-    /**
-     * Clear the screen, a.k.a the pixel buffer with a single color
-     */
-    void clearScreen(Color color) {
-        std::fill(pixelBuffer.begin(), pixelBuffer.end(), RGB(color.b, color.g, color.r));
-    }
-
-    /**
-     * Change a single pixels color in the pixel buffer
-     */
-    void drawPixel(int x, int y, Color color) {
-        if (x >= 0 && x < width && y >= 0 && y < height) {
-            pixelBuffer[y * width + x] = RGB(color.b, color.g, color.r);
-        }
-    }
-
-    /**
-     * Draw a circle to the pixel buffer
-     */
-    void drawCircle(int centerX, int centerY, float radius, Color color) {
-        int minY = centerY - radius;
-        int maxY = centerY + radius;
-        int minX = centerX - radius;
-        int maxX = centerX + radius;
-
-        for (int y = minY; y <= maxY; y++) {
-            for (int x = minX; x <= maxX; x++) {
-                float dx = x - centerX;
-                float dy = y - centerY;
-                float distSquared = dx * dx + dy * dy;
-
-                if (distSquared > radius * radius) continue;
-                drawPixel(x, y, color); 
-            }
-        }
-    }
-
-    /**
-     * Draw a rectangle the pixel buffer
-     * @note rectangle edges alligned with screen edges
-     */
-    void drawRectangle(int x1, int x2, int y1, int y2, Color color) {
-        assert(x1 != x2 && y1 != y2);
-
-        if (x2 <= x1) {
-            auto temp = x2;
-            x2 = x1;
-            x1 = temp;
-        }
-        
-        if (y2 <= y1) {
-            auto temp = y2;
-            y2 = y1;
-            y1 = temp;
-        }
-
-        for (int y = y1; y <= y2; y++) {
-            for (int x = x1; x <= x2; x++) {
-                drawPixel(x, y, color);
-            }
-        }
-    }
-
-    /**
-     * Draw a line to the pixel buffer using Bresenham's line algorithm
-     */
-    void drawLine(int x1, int y1, int x2, int y2, Color color) {
-        float dx = std::abs(x2 - x1);
-        float dy = std::abs(y2 - y1);
-        int sx = (x1 < x2) ? 1 : -1;
-        int sy = (y1 < y2) ? 1 : -1;
-        int err = dx - dy;
-
-        while (x1 != x2 || y1 != y2) {
-            drawPixel(x1, y1, color);
-
-            int e2 = 2 * err;
-            if (e2 > -dy) {
-                err -= dy;
-                x1 += sx;
-            }
-            if (e2 < dx) {
-                err += dx;
-                y1 += sy;
-            }
-        }
-    } 
-
     /**
      * Draws the pixel buffer to the window
      */
     void redraw() {
+        PROFILE_ZONE("Window::redraw");
+
+        framebuffer.flush();
+
         InvalidateRect(hWnd, nullptr, FALSE);
         UpdateWindow(hWnd);
     }
@@ -5,5 +5,13 @@ enum class ComponentID {
     Position,
     TextRender,
     Lifetime,
-    BoundedCollision
+    BoundedCollision,
+    Kinematics,
+    Steering,
+    Energy,
+    Species,
+    RenderStyle,
+    Genes,
+    Lifecycle,
+    SimulationLod
 };
@@ -4,10 +4,23 @@
 #include <unordered_map>
 #include <concepts>
 #include <cassert>
+#include <memory>
+#include <utility>
 
-#include "EntityComponentManager.hpp"
+#include "IComponentPool.hpp"
 #include "IComponent.hpp"
 #include "Entity.hpp"
+#include "LargePageAllocator.hpp"
+
+/**
+ * Allocator policy of the pool of each component type. Specialise it to give one
+ * component a different allocator, e.g. std::allocator; its pool then no longer shows
+ * up in AllocationTracker::getContainerCounts().
+ */
+template<ComponentConcept Component>
+struct ComponentAllocator {
+    using type = LargePageAllocator<Component>;
+};
 
 /**
  * Stores a list of entities and components such that they correspond via a common index.
@@ -20,22 +33,41 @@
  *
  * If an entity doesn't have a component, then it isn't in the corresponding component pool.
  * If an entity has a component, then it is in the corresponding component pool.
+ *
+ * The dense arrays allocate through the Allocator policy, by default LargePageAllocator:
+ * cache line aligned, on huge pages once they are large, and counted in
+ * AllocationTracker::getContainerCounts().
  */
-template<ComponentConcept Component>
+template<ComponentConcept Component, typename Allocator = typename ComponentAllocator<Component>::type>
 struct ComponentPool final : public IComponentPool {
-    std::vector<Component> data;
-    std::vector<Entity> entities;
+    using EntityAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Entity>;
+
+    std::vector<Component, Allocator> data;
+    std::vector<Entity, EntityAllocator> entities;
     std::unordered_map<Entity, std::size_t> lookup;
 
-    ComponentPool(std::size_t reserve = 0) {
-        data.reserve(reserve);
-        entities.reserve(reserve);
+    ComponentPool(std::size_t capacity = 0) {
+        this->reserve(capacity);
+    }
+
+    /**
+     * Makes room for capacity components, so the pool grows in one step instead of by
+     * repeated doubling. Also sizes the lookup map's buckets for them.
+     */
+    void reserve(std::size_t capacity) {
+        this->data.reserve(capacity);
+        this->entities.reserve(capacity);
+        this->lookup.reserve(capacity);
     }
 
     std::size_t getSize() const {
         return this->entities.size();
     }
 
+    std::size_t getCapacity() const {
+        return this->data.capacity();
+    }
+
     bool has(Entity e) const {
         return this->lookup.contains(e);
     }
@@ -46,7 +78,39 @@ struct ComponentPool final : public IComponentPool {
      */
     Component& get(Entity e) {
         assert(this->has(e) && "ComponentPool.get(Entity) precondition violated");
-        return this->data[this->lookup[e]];
+        return this->data[this->lookup.find(e)->second];
+    }
+
+    /**
+     * Neither overload of get() modifies the lookup map, so both are safe to call from
+     * several threads at once as long as no component is added or removed meanwhile.
+     */
+    const Component& get(Entity e) const {
+        assert(this->has(e) && "ComponentPool.get(Entity) precondition violated");
+        return this->data[this->lookup.find(e)->second];
+    }
+
+    /**
+     * Position of the entity in data and entities.
+     * @precondition: the entity is in the component pool.
+     */
+    std::size_t indexOf(Entity e) const {
+        assert(this->has(e) && "ComponentPool.indexOf(Entity) precondition violated");
+        return this->lookup.find(e)->second;
+    }
+
+    /**
+     * Exchanges the entries at two indices, keeping the lookup map in sync.
+     * Lets systems reorder a pool, e.g. to keep related entities contiguous.
+     */
+    void swap(std::size_t a, std::size_t b) {
+        if (a == b) return;
+
+        std::swap(this->entities[a], this->entities[b]);
+        std::swap(this->data[a], this->data[b]);
+
+        this->lookup[this->entities[a]] = a;
+        this->lookup[this->entities[b]] = b;
     }
 
     // TODO: remove the add() and remove() methods from the public interface.
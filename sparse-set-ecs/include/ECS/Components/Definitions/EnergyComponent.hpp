@@ -0,0 +1,21 @@
+#pragma once
+
+#include <iostream>
+
+#include "IComponent.hpp"
+#include "ComponentID.hpp"
+
+struct EnergyComponent final : public IComponent<EnergyComponent> {
+    static ComponentID typeId() {
+        return ComponentID::Energy;
+    }
+
+    float energy;
+
+    EnergyComponent(float energy_) : energy(energy_) {}
+};
+
+std::ostream& operator<<(std::ostream& os, const EnergyComponent c) {
+    os << c.energy;
+    return os;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <iostream>
+#include <algorithm>
+
+#include "IComponent.hpp"
+#include "ComponentID.hpp"
+#include "Random.hpp"
+
+/**
+ * Heritable traits. Only read when a boid is spawned, steers itself or reproduces,
+ * so it lives in its own pool away from the kinematic data scanned by neighbours.
+ */
+struct GenesComponent final : public IComponent<GenesComponent> {
+    static ComponentID typeId() {
+        return ComponentID::Genes;
+    }
+
+    float maxSpeed;
+    float perceptionRadius;
+    float aggression;
+    float fearResponse;
+    float metabolism;
+    float reproductionThreshold;
+
+    GenesComponent() : maxSpeed(150.0f), perceptionRadius(50.0f), aggression(0.5f),
+                       fearResponse(0.5f), metabolism(1.0f), reproductionThreshold(80.0f) {}
+
+    GenesComponent mutate(RandomStream& rng) const {
+        GenesComponent child = *this;
+        child.maxSpeed += rng.uniform(-0.1f, 0.1f) * 30.0f;
+        child.perceptionRadius += rng.uniform(-0.1f, 0.1f) * 10.0f;
+        child.aggression += rng.uniform(-0.1f, 0.1f) * 0.2f;
+        child.fearResponse += rng.uniform(-0.1f, 0.1f) * 0.2f;
+        child.metabolism += rng.uniform(-0.1f, 0.1f) * 0.2f;
+        child.reproductionThreshold += rng.uniform(-0.1f, 0.1f) * 10.0f;
+
+        // Clamp values
+        child.maxSpeed = std::clamp(child.maxSpeed, 50.0f, 250.0f);
+        child.perceptionRadius = std::clamp(child.perceptionRadius, 20.0f, 100.0f);
+        child.aggression = std::clamp(child.aggression, 0.0f, 1.0f);
+        child.fearResponse = std::clamp(child.fearResponse, 0.0f, 1.0f);
+        child.metabolism = std::clamp(child.metabolism, 0.5f, 2.0f);
+        child.reproductionThreshold = std::clamp(child.reproductionThreshold, 60.0f, 95.0f);
+
+        return child;
+    }
+};
+
+std::ostream& operator<<(std::ostream& os, const GenesComponent& c) {
+    os << "speed " << c.maxSpeed << ", perception " << c.perceptionRadius
+       << ", aggression " << c.aggression << ", fear " << c.fearResponse
+       << ", metabolism " << c.metabolism << ", reproduction " << c.reproductionThreshold;
+    return os;
+}
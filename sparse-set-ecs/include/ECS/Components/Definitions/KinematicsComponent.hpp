@@ -0,0 +1,31 @@
+#pragma once
+
+#include <iostream>
+
+#include "IComponent.hpp"
+#include "ComponentID.hpp"
+#include "Vector2.hpp"
+
+/**
+ * Hot per-frame motion state. Kept separate from the tuning data in SteeringComponent
+ * so the integration and neighbour passes only stream the fields they use.
+ */
+struct KinematicsComponent final : public IComponent<KinematicsComponent> {
+    static ComponentID typeId() {
+        return ComponentID::Kinematics;
+    }
+
+    Vector2 position;
+    Vector2 velocity;
+    Vector2 acceleration;
+    Vector2 previousPosition; // position before the last integration step, for render interpolation
+
+    KinematicsComponent(Vector2 position_, Vector2 velocity_)
+        : position(position_), velocity(velocity_), acceleration(0, 0), previousPosition(position_) {}
+};
+
+std::ostream& operator<<(std::ostream& os, const KinematicsComponent& c) {
+    os << "p(" << c.position.x << ',' << c.position.y << ") "
+       << "v(" << c.velocity.x << ',' << c.velocity.y << ')';
+    return os;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <iostream>
+
+#include "IComponent.hpp"
+#include "ComponentID.hpp"
+
+/**
+ * Per-boid bookkeeping for the ecosystem: health, age and reproduction state.
+ */
+struct LifecycleComponent final : public IComponent<LifecycleComponent> {
+    static ComponentID typeId() {
+        return ComponentID::Lifecycle;
+    }
+
+    float health;
+    int generation;
+    int age; // in frames
+    bool isChild;
+    bool isDead;
+    float reproductionCooldown;
+
+    LifecycleComponent(int generation_)
+        : health(100.0f), generation(generation_), age(0), isChild(true),
+          isDead(false), reproductionCooldown(0.0f) {}
+};
+
+std::ostream& operator<<(std::ostream& os, const LifecycleComponent& c) {
+    os << "gen " << c.generation << ", age " << c.age << ", health " << c.health
+       << (c.isChild ? ", child" : "") << (c.isDead ? ", dead" : "");
+    return os;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <cstdint>
 
 #include "IComponent.hpp"
 #include "ComponentID.hpp"
@@ -10,12 +11,17 @@ struct LifetimeComponent final : public IComponent<LifetimeComponent> {
         return ComponentID::Lifetime;
     }
 
-    float seconds_left;
+    // seconds the entity was given when the component was added, not decremented
+    float lifetime;
+    // tick of the lifetime wheel the entity expires on
+    std::uint64_t expiry_tick;
 
-    LifetimeComponent(float seconds_left_) : seconds_left(seconds_left_) {}
+    // made by addLifetime() in LifetimeSystem.hpp, which also schedules expiry_tick on the wheel
+    LifetimeComponent(float lifetime_, std::uint64_t expiry_tick_)
+        : lifetime(lifetime_), expiry_tick(expiry_tick_) {}
 };
 
 std::ostream& operator<<(std::ostream& os, const LifetimeComponent c) {
-    os << c.seconds_left;
+    os << c.lifetime << " s, expires on tick " << c.expiry_tick;
     return os;
 }
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <iostream>
+
+#include "IComponent.hpp"
+#include "ComponentID.hpp"
+#include "Color.hpp"
+
+struct RenderStyleComponent final : public IComponent<RenderStyleComponent> {
+    static ComponentID typeId() {
+        return ComponentID::RenderStyle;
+    }
+
+    Color color;
+    float radius;
+
+    RenderStyleComponent(Color color_, float radius_) : color(color_), radius(radius_) {}
+};
+
+std::ostream& operator<<(std::ostream& os, const RenderStyleComponent& c) {
+    os << "rgb(" << +c.color.r << ',' << +c.color.g << ',' << +c.color.b << ") r=" << c.radius;
+    return os;
+}
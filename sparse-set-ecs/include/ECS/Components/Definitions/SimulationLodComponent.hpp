@@ -0,0 +1,37 @@
+#pragma once
+
+#include <iostream>
+#include <algorithm>
+
+#include "IComponent.hpp"
+#include "ComponentID.hpp"
+
+/**
+ * Simulation level of detail. An entity in tier t runs its behaviour every 2^t frames
+ * and is given all the time accumulated since its last update when it does.
+ * Written by simulationLodSystem.
+ */
+struct SimulationLodComponent final : public IComponent<SimulationLodComponent> {
+    static ComponentID typeId() {
+        return ComponentID::SimulationLod;
+    }
+
+    int tier;
+    float pendingTime;  // time accumulated since the last update
+    float stepTime;     // time to simulate this frame, 0 when the entity is skipped
+    float activeTime;   // while positive the entity is kept at tier 0
+
+    SimulationLodComponent() : tier(0), pendingTime(0.0f), stepTime(0.0f), activeTime(0.0f) {}
+
+    /**
+     * Keeps the entity at full update rate for at least the given time.
+     */
+    void markActive(float seconds) {
+        activeTime = std::max(activeTime, seconds);
+    }
+};
+
+std::ostream& operator<<(std::ostream& os, const SimulationLodComponent& c) {
+    os << "tier " << c.tier << ", pending " << c.pendingTime << "s";
+    return os;
+}
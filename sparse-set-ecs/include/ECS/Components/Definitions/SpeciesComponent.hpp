@@ -0,0 +1,25 @@
+#pragma once
+
+#include <iostream>
+
+#include "IComponent.hpp"
+#include "ComponentID.hpp"
+
+/**
+ * Tags an entity with the species it belongs to.
+ * The meaning of each value is defined by the application using it.
+ */
+struct SpeciesComponent final : public IComponent<SpeciesComponent> {
+    static ComponentID typeId() {
+        return ComponentID::Species;
+    }
+
+    int type;
+
+    SpeciesComponent(int type_) : type(type_) {}
+};
+
+std::ostream& operator<<(std::ostream& os, const SpeciesComponent c) {
+    os << c.type;
+    return os;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <iostream>
+
+#include "IComponent.hpp"
+#include "ComponentID.hpp"
+
+struct SteeringComponent final : public IComponent<SteeringComponent> {
+    static ComponentID typeId() {
+        return ComponentID::Steering;
+    }
+
+    float maxSpeed;
+    float maxForce;
+    float perceptionRadius;
+
+    SteeringComponent(float maxSpeed_, float maxForce_, float perceptionRadius_)
+        : maxSpeed(maxSpeed_), maxForce(maxForce_), perceptionRadius(perceptionRadius_) {}
+};
+
+std::ostream& operator<<(std::ostream& os, const SteeringComponent& c) {
+    os << "speed " << c.maxSpeed << ", force " << c.maxForce << ", perception " << c.perceptionRadius;
+    return os;
+}
@@ -1,7 +1,7 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
-#include <queue>
 #include <unordered_map>
 #include <memory>
 
@@ -9,6 +9,7 @@
 #include "IComponentPool.hpp"
 #include "ComponentPool.hpp"
 #include "Entity.hpp"
+#include "Profiler.hpp"
 
 constexpr std::size_t DEFAULT_CAPACITY = 20;
 
@@ -16,12 +17,12 @@ class EntityComponentManager {
 public:
     class EntityRemover {
     private:
-        std::queue<Entity> deleteQueue;
+        std::vector<Entity> deleteQueue; // keeps its capacity between frames
         EntityRemover() = default;
         friend class EntityComponentManager;
     public:
         void add(Entity e) {
-            deleteQueue.push(e);
+            deleteQueue.push_back(e);
         }
     };
 
@@ -76,17 +77,25 @@ public:
     }
 
     void deleteEntities() {
-        while (!entityRemover.deleteQueue.empty()) {
-            auto e = entityRemover.deleteQueue.front();
-            entityRemover.deleteQueue.pop();
+        PROFILE_ZONE("deleteEntities");
+
+        for (Entity e : entityRemover.deleteQueue) {
             deleteEntity(e);
         }
+        entityRemover.deleteQueue.clear();
     }
 
     const std::vector<Entity>& getEntities() const {
         return entities;
     }
 
+    /**
+     * Capacity hint for the number of live entities.
+     */
+    void reserveEntities(std::size_t capacity) {
+        entities.reserve(capacity);
+    }
+
     // ---------------------------------------------------
     // Component Management
     // ---------------------------------------------------
@@ -102,6 +111,21 @@ public:
         pool.remove(e);
     }
 
+    /**
+     * Capacity hint: sizes the pool of Component for capacity entries up front, so a pool
+     * known to get large is allocated once instead of growing from DEFAULT_CAPACITY.
+     */
+    template<ComponentConcept Component>
+    void reserveComponents(std::size_t capacity) {
+        auto typeId = Component::typeId();
+
+        if (!componentPools.contains(typeId)) {
+            componentPools[typeId] = std::make_unique<ComponentPool<Component>>(std::max(capacity, DEFAULT_CAPACITY));
+        } else {
+            this->getPool<Component>().reserve(capacity);
+        }
+    }
+
     template<ComponentConcept Component>
     ComponentPool<Component>& getPool() {
         auto typeId = Component::typeId();
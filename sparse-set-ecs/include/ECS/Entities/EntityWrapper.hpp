@@ -14,6 +14,10 @@ public:
     EntityID getId() {
         return e.getId();
     }
+
+    Entity getEntity() const {
+        return e;
+    }
     
     template<ComponentConcept Component>
     void addComponent(Component c) {
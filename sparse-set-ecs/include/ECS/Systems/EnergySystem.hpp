@@ -0,0 +1,27 @@
+#pragma once
+
+#include "ComponentPool.hpp"
+#include "EnergyComponent.hpp"
+#include "EntityComponentManager.hpp"
+#include "Profiler.hpp"
+
+/**
+ * Drains energy at a constant rate and queues entities that run out for deletion.
+ */
+void energySystem(
+    ComponentPool<EnergyComponent>& energyPool,
+    EntityComponentManager::EntityRemover& entityRemover,
+    float drainPerSecond,
+    float deltaTime
+) {
+    PROFILE_ZONE("energySystem");
+
+    for (std::size_t i = 0; i < energyPool.getSize(); ++i) {
+        auto& energy = energyPool.data[i];
+        energy.energy -= drainPerSecond * deltaTime;
+
+        if (energy.energy <= 0.0f) {
+            entityRemover.add(energyPool.entities[i]);
+        }
+    }
+}
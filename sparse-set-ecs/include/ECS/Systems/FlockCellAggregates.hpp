@@ -0,0 +1,152 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+#include "FlockSnapshot.hpp"
+#include "FrameArena.hpp"
+#include "Vector2.hpp"
+#include "Profiler.hpp"
+
+/**
+ * Per-cell, per-species sums of a FlockSnapshot on a uniform grid.
+ *
+ * Built once per frame in O(n). Alignment and cohesion can then be approximated from the
+ * cells around a boid instead of visiting every neighbour, trading accuracy at the edge of
+ * the perception radius for O(cells) work per boid. Smaller cells give a closer fit.
+ *
+ * build() also sorts the snapshot indices by cell, so the interactions that stay exact,
+ * such as separation, can query() the boids around a position instead of scanning all.
+ */
+struct FlockCellAggregates {
+    struct Cell {
+        int count = 0;
+        Vector2 velocitySum;
+        Vector2 positionSum;
+    };
+
+    float cellSize = 50.0f;
+    int width = 0;
+    int height = 0;
+    int speciesCount = 0;
+
+    // indexed by (y * width + x) * speciesCount + species
+    std::vector<Cell> cells;
+
+    // snapshot indices sorted by cell, those in cell c are boids[cellStart[c], cellStart[c + 1])
+    std::vector<std::uint32_t> cellStart;
+    std::vector<int> boids;
+    std::vector<std::uint32_t> boidCell; // scratch for build()
+
+    void initialize(float worldWidth, float worldHeight, float cellSize_, int speciesCount_) {
+        cellSize = cellSize_;
+        width = static_cast<int>(worldWidth / cellSize) + 1;
+        height = static_cast<int>(worldHeight / cellSize) + 1;
+        speciesCount = speciesCount_;
+        cells.assign(static_cast<std::size_t>(width) * height * speciesCount, Cell{});
+        cellStart.assign(static_cast<std::size_t>(width) * height + 1, 0);
+    }
+
+    void build(const FlockSnapshot& snapshot) {
+        PROFILE_ZONE("FlockCellAggregates::build");
+
+        std::fill(cells.begin(), cells.end(), Cell{});
+        std::fill(cellStart.begin(), cellStart.end(), 0);
+        boidCell.resize(snapshot.getSize());
+
+        for (std::size_t i = 0; i < snapshot.getSize(); ++i) {
+            int x = std::clamp(static_cast<int>(snapshot.positions[i].x / cellSize), 0, width - 1);
+            int y = std::clamp(static_cast<int>(snapshot.positions[i].y / cellSize), 0, height - 1);
+            boidCell[i] = static_cast<std::uint32_t>(y * width + x);
+            cellStart[boidCell[i] + 1]++;
+
+            int species = snapshot.species[i];
+            if (species < 0 || species >= speciesCount) continue;
+
+            Cell& cell = cells[boidCell[i] * speciesCount + species];
+            cell.count++;
+            cell.velocitySum += snapshot.velocities[i];
+            cell.positionSum += snapshot.positions[i];
+        }
+
+        // counting sort of the indices by cell
+        for (std::size_t c = 1; c < cellStart.size(); ++c) {
+            cellStart[c] += cellStart[c - 1];
+        }
+        boids.resize(snapshot.getSize());
+        for (std::size_t i = 0; i < snapshot.getSize(); ++i) {
+            boids[cellStart[boidCell[i]]++] = static_cast<int>(i);
+        }
+        // the placement advanced every start to the next cell's, shift them back
+        for (std::size_t c = cellStart.size() - 1; c > 0; --c) {
+            cellStart[c] = cellStart[c - 1];
+        }
+        cellStart[0] = 0;
+    }
+
+    /**
+     * Fills result with the snapshot indices of every boid in the cells touched by the
+     * square of half-size radius around position, of any species.
+     */
+    void query(const Vector2& position, float radius, FrameVector<int>& result) const {
+        result.clear();
+
+        int minX = std::max(0, static_cast<int>((position.x - radius) / cellSize));
+        int maxX = std::min(width - 1, static_cast<int>((position.x + radius) / cellSize));
+        int minY = std::max(0, static_cast<int>((position.y - radius) / cellSize));
+        int maxY = std::min(height - 1, static_cast<int>((position.y + radius) / cellSize));
+        if (minX > maxX || minY > maxY) return;
+
+        // a row of cells is contiguous in boids
+        std::size_t total = 0;
+        for (int y = minY; y <= maxY; ++y) {
+            total += cellStart[y * width + maxX + 1] - cellStart[y * width + minX];
+        }
+        result.reserve(total);
+
+        for (int y = minY; y <= maxY; ++y) {
+            result.insert(result.end(), boids.begin() + cellStart[y * width + minX], boids.begin() + cellStart[y * width + maxX + 1]);
+        }
+    }
+
+    /**
+     * Sums the aggregates of one species over every cell touched by the square
+     * of half-size radius around position.
+     */
+    Cell gather(const Vector2& position, float radius, int species) const {
+        Cell total;
+        if (species < 0 || species >= speciesCount) return total;
+
+        int minX = std::max(0, static_cast<int>((position.x - radius) / cellSize));
+        int maxX = std::min(width - 1, static_cast<int>((position.x + radius) / cellSize));
+        int minY = std::max(0, static_cast<int>((position.y - radius) / cellSize));
+        int maxY = std::min(height - 1, static_cast<int>((position.y + radius) / cellSize));
+
+        for (int y = minY; y <= maxY; ++y) {
+            for (int x = minX; x <= maxX; ++x) {
+                const Cell& cell = cells[(y * width + x) * speciesCount + species];
+                total.count += cell.count;
+                total.velocitySum += cell.velocitySum;
+                total.positionSum += cell.positionSum;
+            }
+        }
+
+        return total;
+    }
+
+    /**
+     * Same as gather(), but with the contribution of the querying boid removed.
+     */
+    Cell gatherNeighbours(const Vector2& position, const Vector2& velocity, float radius, int species) const {
+        Cell total = gather(position, radius, species);
+
+        if (total.count > 0) {
+            total.count--;
+            total.velocitySum -= velocity;
+            total.positionSum -= position;
+        }
+
+        return total;
+    }
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+#include "ComponentPool.hpp"
+#include "KinematicsComponent.hpp"
+#include "SpeciesComponent.hpp"
+#include "Vector2.hpp"
+#include "Profiler.hpp"
+
+/**
+ * Packed, read-only copy of a flock's position, velocity and species taken before the
+ * steering pass. Neighbour scans read these arrays instead of the component pools, so
+ * forces can be written back to the pools from several threads while the scan runs.
+ *
+ * Index i of the snapshot matches index i of the kinematics pool it was captured from,
+ * until entities are added to or removed from that pool.
+ */
+struct FlockSnapshot {
+    std::vector<Entity> entities;
+    std::vector<Vector2> positions;
+    std::vector<Vector2> velocities;
+    std::vector<int> species;
+
+    std::size_t getSize() const {
+        return this->entities.size();
+    }
+
+    void capture(
+        const ComponentPool<KinematicsComponent>& kinematicsPool,
+        const ComponentPool<SpeciesComponent>& speciesPool
+    ) {
+        PROFILE_ZONE("FlockSnapshot::capture");
+
+        std::size_t size = kinematicsPool.getSize();
+
+        this->entities.assign(kinematicsPool.entities.begin(), kinematicsPool.entities.end());
+        this->positions.resize(size);
+        this->velocities.resize(size);
+        this->species.resize(size);
+
+        for (std::size_t i = 0; i < size; ++i) {
+            Entity e = kinematicsPool.entities[i];
+            const auto& kinematics = kinematicsPool.data[i];
+
+            this->positions[i] = kinematics.position;
+            this->velocities[i] = kinematics.velocity;
+            this->species[i] = speciesPool.has(e) ? speciesPool.get(e).type : -1;
+        }
+    }
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ComponentPool.hpp"
+#include "KinematicsComponent.hpp"
+#include "SteeringComponent.hpp"
+#include "VectorMath.hpp"
+#include "AllocationTracker.hpp"
+#include "Profiler.hpp"
+
+/**
+ * Integrates the accumulated acceleration into velocity and position, then clears it.
+ * Entities with a SteeringComponent have their speed limited to maxSpeed.
+ * The position before the step is kept in previousPosition.
+ */
+void kinematicsSystem(
+    ComponentPool<KinematicsComponent>& kinematicsPool,
+    const ComponentPool<SteeringComponent>& steeringPool,
+    float deltaTime
+) {
+    PROFILE_ZONE("kinematicsSystem");
+    ASSERT_NO_ALLOCATIONS();
+
+    for (std::size_t i = 0; i < kinematicsPool.getSize(); ++i) {
+        Entity e = kinematicsPool.entities[i];
+        auto& kinematics = kinematicsPool.data[i];
+
+        kinematics.velocity += kinematics.acceleration * deltaTime;
+
+        if (steeringPool.has(e)) {
+            kinematics.velocity = VectorMath::limit(kinematics.velocity, steeringPool.get(e).maxSpeed);
+        }
+
+        kinematics.previousPosition = kinematics.position;
+        kinematics.position += kinematics.velocity * deltaTime;
+        kinematics.acceleration = Vector2(0, 0);
+    }
+}
+
+/**
+ * Wraps positions that left the [0, worldWidth] x [0, worldHeight] rectangle to the opposite edge.
+ * previousPosition is moved along, so interpolating between the two doesn't sweep across the world.
+ */
+void worldWrapSystem(
+    ComponentPool<KinematicsComponent>& kinematicsPool,
+    float worldWidth,
+    float worldHeight
+) {
+    PROFILE_ZONE("worldWrapSystem");
+    ASSERT_NO_ALLOCATIONS();
+
+    for (auto& kinematics : kinematicsPool.data) {
+        Vector2& position = kinematics.position;
+        Vector2 unwrapped = position;
+
+        if (position.x < 0) position.x = worldWidth;
+        if (position.x > worldWidth) position.x = 0;
+        if (position.y < 0) position.y = worldHeight;
+        if (position.y > worldHeight) position.y = 0;
+
+        kinematics.previousPosition += position - unwrapped;
+    }
+}
@@ -3,20 +3,48 @@
 #include "ComponentPool.hpp"
 #include "LifetimeComponent.hpp"
 #include "EntityComponentManager.hpp"
+#include "TimerWheel.hpp"
+#include "Profiler.hpp"
 
+/**
+ * Gives an entity a LifetimeComponent and schedules its expiry on the wheel.
+ * An entity that already has one gets the new lifetime instead, counted from now.
+ * Lifetimes added any other way are never expired by lifetimeSystem.
+ */
+void addLifetime(TimerWheel& lifetimeWheel, Entity e, float seconds) {
+    EntityComponentManager& ecm = EntityComponentManager::getInstance();
+    TimerWheel::Tick expiry = lifetimeWheel.expiryAfter(seconds);
+
+    auto& lifetimePool = ecm.getPool<LifetimeComponent>();
+    if (lifetimePool.has(e)) {
+        auto& lifetime = lifetimePool.get(e);
+        lifetime.lifetime = seconds;
+        lifetime.expiry_tick = expiry;
+    } else {
+        ecm.addComponent(e, LifetimeComponent{seconds, expiry});
+    }
+    lifetimeWheel.schedule(e, expiry);
+}
+
+/**
+ * Advances the wheel and queues every entity whose lifetime ran out for removal.
+ * Only the wheel slots that elapsed are visited, not every LifetimeComponent.
+ *
+ * Timers of entities that were removed early, or whose lifetime was replaced by a later
+ * addLifetime(), no longer match a component and are dropped.
+ */
 void lifetimeSystem(
-    ComponentPool<LifetimeComponent>& lifetimePool,
+    const ComponentPool<LifetimeComponent>& lifetimePool,
+    TimerWheel& lifetimeWheel,
     EntityComponentManager::EntityRemover& entityRemover,
     float deltaTime
 ) {
-    for (std::size_t i = 0; i < lifetimePool.getSize(); ++i) {
-        Entity e = lifetimePool.entities[i];
-        
-        auto& lifetime = lifetimePool.data[i];
-        lifetime.seconds_left -= deltaTime;
+    PROFILE_ZONE("lifetimeSystem");
+
+    for (const auto& timer : lifetimeWheel.advance(deltaTime)) {
+        if (!lifetimePool.has(timer.entity)) continue;
+        if (lifetimePool.get(timer.entity).expiry_tick != timer.expiry) continue;
 
-        if (lifetime.seconds_left <= 0.0f) {
-            entityRemover.add(e);
-        }
+        entityRemover.add(timer.entity);
     }
-}
\ No newline at end of file
+}
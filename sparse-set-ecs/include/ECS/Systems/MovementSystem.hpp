@@ -3,12 +3,17 @@
 #include "ComponentPool.hpp"
 #include "PositionComponent.hpp"
 #include "VelocityComponent.hpp"
+#include "AllocationTracker.hpp"
+#include "Profiler.hpp"
 
 void movementSystem(
     ComponentPool<PositionComponent>& positionPool,
     ComponentPool<VelocityComponent>& velocityPool,
     float deltaTime
 ) {
+    PROFILE_ZONE("movementSystem");
+    ASSERT_NO_ALLOCATIONS();
+
     for (std::size_t i = 0; i < velocityPool.getSize(); ++i) {
         Entity e = velocityPool.entities[i];
 
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+
+#include "ComponentPool.hpp"
+#include "KinematicsComponent.hpp"
+#include "SimulationLodComponent.hpp"
+#include "AllocationTracker.hpp"
+#include "Profiler.hpp"
+
+/**
+ * Describes how entities are assigned to update-frequency tiers.
+ * The focus region is given in world space, usually the camera space of the renderer.
+ */
+struct SimulationLodPolicy {
+    float top, bottom, left, right;
+    float tierDistance; // distance outside the focus region that costs one tier
+    int idleTier;       // lowest tier for entities that are not active
+    int maxTier;
+};
+
+/**
+ * Assigns each entity a tier from its distance to the focus region and its activity, then
+ * decides whether it updates this frame. Updates of a tier are staggered by entity id so
+ * that only 1 / 2^tier of the entities in it run on any frame.
+ */
+void simulationLodSystem(
+    ComponentPool<SimulationLodComponent>& lodPool,
+    const ComponentPool<KinematicsComponent>& kinematicsPool,
+    const SimulationLodPolicy& policy,
+    unsigned frame,
+    float deltaTime
+) {
+    PROFILE_ZONE("simulationLodSystem");
+    ASSERT_NO_ALLOCATIONS();
+
+    float minX = std::min(policy.left, policy.right);
+    float maxX = std::max(policy.left, policy.right);
+    float minY = std::min(policy.top, policy.bottom);
+    float maxY = std::max(policy.top, policy.bottom);
+
+    for (std::size_t i = 0; i < lodPool.getSize(); ++i) {
+        Entity e = lodPool.entities[i];
+        auto& lod = lodPool.data[i];
+
+        lod.activeTime = std::max(0.0f, lod.activeTime - deltaTime);
+        lod.pendingTime += deltaTime;
+
+        if (lod.activeTime > 0.0f) {
+            lod.tier = 0;
+        } else {
+            int tier = policy.idleTier;
+
+            if (kinematicsPool.has(e)) {
+                const Vector2& position = kinematicsPool.get(e).position;
+                float dx = std::max({minX - position.x, 0.0f, position.x - maxX});
+                float dy = std::max({minY - position.y, 0.0f, position.y - maxY});
+                float distance = std::sqrt(dx * dx + dy * dy);
+
+                if (distance > 0.0f) {
+                    tier = std::max(tier, 1 + static_cast<int>(distance / policy.tierDistance));
+                }
+            }
+
+            lod.tier = std::min(tier, policy.maxTier);
+        }
+
+        unsigned period = 1u << lod.tier;
+        if (((frame + e.getId()) & (period - 1)) == 0) {
+            lod.stepTime = lod.pendingTime;
+            lod.pendingTime = 0.0f;
+        } else {
+            lod.stepTime = 0.0f;
+        }
+    }
+}
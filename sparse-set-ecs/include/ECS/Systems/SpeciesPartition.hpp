@@ -0,0 +1,102 @@
+#pragma once
+
+#include <vector>
+
+#include "ComponentPool.hpp"
+#include "KinematicsComponent.hpp"
+#include "SpeciesComponent.hpp"
+#include "Profiler.hpp"
+
+/**
+ * Keeps the kinematics pool ordered by species, so every species occupies one contiguous
+ * index range and per-species passes can run over a range without checking each entity.
+ *
+ * Spawns append to the end of the pool and removals move the last entry into the hole,
+ * so only a handful of entries are out of place after each frame. update() swaps those
+ * back into their species' range and leaves everything else where it is.
+ */
+struct SpeciesPartition {
+    struct Range {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+
+        std::size_t getSize() const {
+            return end - begin;
+        }
+    };
+
+    int speciesCount = 0;
+
+    // species s occupies [offsets[s], offsets[s + 1])
+    std::vector<std::size_t> offsets;
+
+    // scratch space for update()
+    std::vector<int> speciesByIndex;
+    std::vector<std::size_t> counts;
+    std::vector<std::size_t> next;
+
+    void initialize(int speciesCount_) {
+        speciesCount = speciesCount_;
+        offsets.assign(speciesCount + 1, 0);
+    }
+
+    /**
+     * @return the empty range for species outside [0, speciesCount)
+     */
+    Range getRange(int species) const {
+        if (species < 0 || species >= speciesCount) return Range{};
+        return Range{offsets[species], offsets[species + 1]};
+    }
+
+    /**
+     * Reorders the kinematics pool so it is grouped by species. Entities without a species,
+     * or with one outside [0, speciesCount), are kept after the last range.
+     * Must run while no other code holds indices into the pool, e.g. before a snapshot is captured.
+     */
+    void update(
+        ComponentPool<KinematicsComponent>& kinematicsPool,
+        const ComponentPool<SpeciesComponent>& speciesPool
+    ) {
+        PROFILE_ZONE("SpeciesPartition::update");
+
+        std::size_t size = kinematicsPool.getSize();
+        speciesByIndex.resize(size);
+
+        // the extra bucket collects entities without a valid species
+        counts.assign(speciesCount + 1, 0);
+        for (std::size_t i = 0; i < size; ++i) {
+            Entity e = kinematicsPool.entities[i];
+            int species = speciesPool.has(e) ? speciesPool.get(e).type : -1;
+            if (species < 0 || species >= speciesCount) species = speciesCount;
+
+            speciesByIndex[i] = species;
+            counts[species]++;
+        }
+
+        offsets[0] = 0;
+        for (int s = 0; s < speciesCount; ++s) {
+            offsets[s + 1] = offsets[s] + counts[s];
+        }
+
+        // in-place bucket placement: each misplaced entry is swapped straight into the next
+        // free slot of its own range, so every entry moves at most once
+        next.assign(offsets.begin(), offsets.end());
+        for (int s = 0; s <= speciesCount; ++s) {
+            std::size_t end = (s < speciesCount) ? offsets[s + 1] : size;
+
+            while (next[s] < end) {
+                std::size_t i = next[s];
+                int species = speciesByIndex[i];
+
+                if (species == s) {
+                    next[s]++;
+                    continue;
+                }
+
+                std::size_t target = next[species]++;
+                kinematicsPool.swap(i, target);
+                std::swap(speciesByIndex[i], speciesByIndex[target]);
+            }
+        }
+    }
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Entity.hpp"
+
+/**
+ * Hierarchical timer wheel of entities keyed on an absolute expiry tick.
+ *
+ * Level 0 holds timers due within the next 64 ticks, one slot per tick. Each level above
+ * covers 64 times the span of the one below with coarser slots, and its timers are moved
+ * down a level when the wheel reaches their slot. Scheduling is O(1), and advancing only
+ * touches the slots that elapsed, however many timers are pending.
+ */
+class TimerWheel {
+public:
+    using Tick = std::uint64_t;
+
+    struct Timer {
+        Entity entity;
+        Tick expiry;
+    };
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 6;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr Tick MAX_DELAY = (Tick{1} << (LEVELS * SLOT_BITS)) - 1;
+
+    std::array<std::array<std::vector<Timer>, SLOTS>, LEVELS> slots;
+    std::vector<Timer> cascading;
+    std::vector<Timer> expired;
+
+    float tickSeconds;
+    float accumulator = 0.0f;
+    Tick currentTick = 0;
+    std::size_t pending = 0;
+
+    void insert(const Timer& timer) {
+        Tick delay = timer.expiry - currentTick;
+
+        int level = 0;
+        while (level < LEVELS - 1 && delay >= (Tick{1} << ((level + 1) * SLOT_BITS))) {
+            level++;
+        }
+
+        std::size_t slot = (timer.expiry >> (level * SLOT_BITS)) & (SLOTS - 1);
+        slots[level][slot].push_back(timer);
+    }
+
+    // moves the timers of the level's current slot down to the levels below
+    void cascade(int level) {
+        std::size_t slot = (currentTick >> (level * SLOT_BITS)) & (SLOTS - 1);
+
+        // none of the timers can land back in this slot, they are all due within its span
+        cascading.swap(slots[level][slot]);
+        for (const Timer& timer : cascading) {
+            insert(timer);
+        }
+        cascading.clear();
+    }
+
+public:
+    /**
+     * @param tickSeconds_ the resolution of the wheel, expiry times are rounded up to it
+     */
+    explicit TimerWheel(float tickSeconds_ = 1.0f / 64.0f) : tickSeconds(tickSeconds_) {}
+
+    Tick getCurrentTick() const {
+        return currentTick;
+    }
+
+    std::size_t getPendingCount() const {
+        return pending;
+    }
+
+    /**
+     * Converts a delay from now into the tick it expires on. Always at least one tick ahead.
+     */
+    Tick expiryAfter(float seconds) const {
+        float ticks = std::ceil(seconds / tickSeconds);
+        Tick delay = 1;
+        if (ticks >= static_cast<float>(MAX_DELAY)) delay = MAX_DELAY;
+        else if (ticks > 1.0f) delay = static_cast<Tick>(ticks);
+        return currentTick + delay;
+    }
+
+    /**
+     * @precondition: expiry > getCurrentTick() and expiry - getCurrentTick() fits in the wheel,
+     *                which expiryAfter() guarantees
+     */
+    void schedule(Entity e, Tick expiry) {
+        insert(Timer{e, expiry});
+        pending++;
+    }
+
+    /**
+     * Moves the wheel forward by deltaTime.
+     * @return every timer that expired, in expiry order. Valid until the next call.
+     */
+    const std::vector<Timer>& advance(float deltaTime) {
+        expired.clear();
+        accumulator += deltaTime;
+
+        while (accumulator >= tickSeconds) {
+            accumulator -= tickSeconds;
+            currentTick++;
+
+            // coarser levels first, so timers they hand down to a slot that is due now get handled this tick
+            for (int level = LEVELS - 1; level > 0; --level) {
+                if ((currentTick & ((Tick{1} << (level * SLOT_BITS)) - 1)) == 0) {
+                    cascade(level);
+                }
+            }
+
+            auto& due = slots[0][currentTick & (SLOTS - 1)];
+            expired.insert(expired.end(), due.begin(), due.end());
+            pending -= due.size();
+            due.clear();
+        }
+
+        return expired;
+    }
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+
+#include "ComponentPool.hpp"
+#include "KinematicsComponent.hpp"
+#include "Vector2.hpp"
+#include "Vector2x8.hpp"
+#include "ViewBounds.hpp"
+#include "Profiler.hpp"
+
+/**
+ * Writes the kinematics pool indices of the entities positioned inside view into visible,
+ * in pool order. The render positions, previousPosition blended towards position by alpha,
+ * are written to positions for every entity first, so the bounds test runs eight at a time
+ * and the caller can draw from them.
+ */
+void viewCullingSystem(
+    const ComponentPool<KinematicsComponent>& kinematicsPool,
+    const ViewBounds& view,
+    float alpha,
+    std::vector<Vector2>& positions,
+    std::vector<int>& visible
+) {
+    PROFILE_ZONE("viewCullingSystem");
+
+    std::size_t count = kinematicsPool.getSize();
+
+    positions.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& kinematics = kinematicsPool.data[i];
+        positions[i] = kinematics.previousPosition + (kinematics.position - kinematics.previousPosition) * alpha;
+    }
+
+    visible.resize(count);
+    std::size_t found = VectorBatch::withinBounds(positions.data(), count, view.min, view.max, visible.data());
+    visible.resize(found);
+}
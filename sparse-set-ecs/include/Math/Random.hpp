@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+/**
+ * Counter-based random numbers.
+ *
+ * Every value is a hash of (key, counter), so a stream holds no state beyond those two
+ * integers and any number of independent streams can be derived from one seed. Deriving
+ * a stream from an entity id gives that entity the same numbers no matter which thread
+ * draws them or in what order.
+ */
+namespace Random {
+    // SplitMix64 finaliser
+    inline std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        x ^= x >> 31;
+        return x;
+    }
+
+    inline std::uint64_t combine(std::uint64_t key, std::uint64_t value) {
+        return mix(key ^ mix(value + 0x9E3779B97F4A7C15ull));
+    }
+
+    /**
+     * Picks a fresh seed from the OS when none is given.
+     */
+    inline std::uint64_t makeSeed(std::uint64_t seed = 0) {
+        if (seed != 0) return seed;
+        std::random_device device;
+        return (static_cast<std::uint64_t>(device()) << 32) | device();
+    }
+}
+
+/**
+ * One independent sequence of random numbers. Cheap to copy and to construct on the stack.
+ */
+class RandomStream {
+private:
+    std::uint64_t m_key;
+    std::uint64_t m_counter;
+
+public:
+    explicit RandomStream(std::uint64_t key = 0, std::uint64_t counter = 0)
+        : m_key(key), m_counter(counter) {}
+
+    std::uint64_t nextU64() {
+        return Random::mix(m_key ^ (++m_counter * 0x9E3779B97F4A7C15ull));
+    }
+
+    std::uint32_t nextU32() {
+        return static_cast<std::uint32_t>(nextU64() >> 32);
+    }
+
+    /**
+     * Uniform float in [0, 1).
+     */
+    float nextFloat() {
+        return static_cast<float>(nextU64() >> 40) * (1.0f / 16777216.0f);
+    }
+
+    /**
+     * Uniform float in [min, max).
+     */
+    float uniform(float min, float max) {
+        return min + (max - min) * nextFloat();
+    }
+
+    /**
+     * Uniform int in [min, max], both inclusive.
+     */
+    int uniformInt(int min, int max) {
+        std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min) + 1;
+        return min + static_cast<int>((static_cast<std::uint64_t>(nextU32()) * range) >> 32);
+    }
+
+    bool chance(float probability) {
+        return nextFloat() < probability;
+    }
+};
+
+/**
+ * Derives streams from a single seed. The same seed always produces the same streams.
+ */
+class RandomSource {
+private:
+    std::uint64_t m_seed;
+
+public:
+    // distinguishes streams drawn for different purposes from the same id
+    enum class Purpose : std::uint64_t {
+        Main,
+        Spawn,
+        Birth,
+        Effects,
+        Worker
+    };
+
+    explicit RandomSource(std::uint64_t seed = 0) : m_seed(Random::makeSeed(seed)) {}
+
+    std::uint64_t getSeed() const {
+        return m_seed;
+    }
+
+    RandomStream stream(Purpose purpose, std::uint64_t id = 0) const {
+        return RandomStream(Random::combine(Random::combine(m_seed, static_cast<std::uint64_t>(purpose)), id));
+    }
+
+    /**
+     * Stream for one entity, e.g. entityStream(Purpose::Spawn, entity.getId()).
+     * @param salt separates repeated draws for the same entity, such as one per frame
+     */
+    RandomStream entityStream(Purpose purpose, std::uint64_t entityId, std::uint64_t salt = 0) const {
+        return RandomStream(Random::combine(stream(purpose, entityId).nextU64(), salt));
+    }
+
+    /**
+     * Stream for a pool worker (see ThreadPool::getWorkerIndex). Only deterministic when
+     * the work each worker receives is, so prefer entityStream for simulation state.
+     */
+    RandomStream workerStream(std::size_t workerIndex, std::uint64_t salt = 0) const {
+        return entityStream(Purpose::Worker, workerIndex, salt);
+    }
+};
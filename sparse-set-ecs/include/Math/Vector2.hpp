@@ -7,7 +7,6 @@ struct Vector2 {
 
     Vector2(float x_, float y_) : x(x_), y(y_) {}
     Vector2() : x(0), y(0) {}
-    Vector2(const Vector2& other) : x(other.x), y(other.y) {}
 
     float magnitude() const {
         return std::sqrt(x * x + y * y);
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define VECTOR2X8_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define VECTOR2X8_SSE2
+#endif
+
+#include "Vector2.hpp"
+
+static_assert(sizeof(Vector2) == 2 * sizeof(float) && std::is_trivially_copyable_v<Vector2>,
+              "Vector2 arrays are loaded as packed float pairs");
+
+/**
+ * Eight floats operated on together. Uses one AVX2 register, two SSE2 registers, or a
+ * plain array when neither is available (build with -mavx2 to get the widest path).
+ *
+ * Comparisons return a mask with every bit of a lane set where the comparison holds.
+ */
+struct Float8 {
+#if defined(VECTOR2X8_AVX2)
+    __m256 v;
+
+    static Float8 load(const float* p) { return {_mm256_loadu_ps(p)}; }
+    static Float8 broadcast(float f) { return {_mm256_set1_ps(f)}; }
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+
+    Float8 operator+(const Float8& o) const { return {_mm256_add_ps(v, o.v)}; }
+    Float8 operator-(const Float8& o) const { return {_mm256_sub_ps(v, o.v)}; }
+    Float8 operator*(const Float8& o) const { return {_mm256_mul_ps(v, o.v)}; }
+    Float8 operator&(const Float8& o) const { return {_mm256_and_ps(v, o.v)}; }
+
+    Float8 operator<(const Float8& o) const { return {_mm256_cmp_ps(v, o.v, _CMP_LT_OQ)}; }
+    Float8 operator>(const Float8& o) const { return {_mm256_cmp_ps(v, o.v, _CMP_GT_OQ)}; }
+
+    // bit i set where lane i of the mask is set
+    int maskBits() const { return _mm256_movemask_ps(v); }
+#elif defined(VECTOR2X8_SSE2)
+    __m128 lo, hi;
+
+    static Float8 load(const float* p) { return {_mm_loadu_ps(p), _mm_loadu_ps(p + 4)}; }
+    static Float8 broadcast(float f) { return {_mm_set1_ps(f), _mm_set1_ps(f)}; }
+    void store(float* p) const { _mm_storeu_ps(p, lo); _mm_storeu_ps(p + 4, hi); }
+
+    Float8 operator+(const Float8& o) const { return {_mm_add_ps(lo, o.lo), _mm_add_ps(hi, o.hi)}; }
+    Float8 operator-(const Float8& o) const { return {_mm_sub_ps(lo, o.lo), _mm_sub_ps(hi, o.hi)}; }
+    Float8 operator*(const Float8& o) const { return {_mm_mul_ps(lo, o.lo), _mm_mul_ps(hi, o.hi)}; }
+    Float8 operator&(const Float8& o) const { return {_mm_and_ps(lo, o.lo), _mm_and_ps(hi, o.hi)}; }
+
+    Float8 operator<(const Float8& o) const { return {_mm_cmplt_ps(lo, o.lo), _mm_cmplt_ps(hi, o.hi)}; }
+    Float8 operator>(const Float8& o) const { return {_mm_cmpgt_ps(lo, o.lo), _mm_cmpgt_ps(hi, o.hi)}; }
+
+    int maskBits() const { return _mm_movemask_ps(lo) | (_mm_movemask_ps(hi) << 4); }
+#else
+    float v[8];
+
+    template<typename Op>
+    static Float8 map(const Float8& a, const Float8& b, Op op) {
+        Float8 r;
+        for (int i = 0; i < 8; ++i) r.v[i] = op(a.v[i], b.v[i]);
+        return r;
+    }
+
+    static float fromBits(std::uint32_t bits) {
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    static std::uint32_t toBits(float f) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    static Float8 load(const float* p) { Float8 r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+    static Float8 broadcast(float f) { Float8 r; for (float& x : r.v) x = f; return r; }
+    void store(float* p) const { std::memcpy(p, v, sizeof(v)); }
+
+    Float8 operator+(const Float8& o) const { return map(*this, o, [](float a, float b) { return a + b; }); }
+    Float8 operator-(const Float8& o) const { return map(*this, o, [](float a, float b) { return a - b; }); }
+    Float8 operator*(const Float8& o) const { return map(*this, o, [](float a, float b) { return a * b; }); }
+    Float8 operator&(const Float8& o) const {
+        return map(*this, o, [](float a, float b) { return fromBits(toBits(a) & toBits(b)); });
+    }
+
+    Float8 operator<(const Float8& o) const {
+        return map(*this, o, [](float a, float b) { return fromBits(a < b ? ~0u : 0u); });
+    }
+    Float8 operator>(const Float8& o) const {
+        return map(*this, o, [](float a, float b) { return fromBits(a > b ? ~0u : 0u); });
+    }
+
+    int maskBits() const {
+        int bits = 0;
+        for (int i = 0; i < 8; ++i) bits |= (toBits(v[i]) >> 31) << i;
+        return bits;
+    }
+#endif
+};
+
+/**
+ * Eight Vector2s held as separate x and y lanes.
+ */
+struct Vector2x8 {
+    Float8 x, y;
+
+    /**
+     * Loads eight consecutive Vector2s.
+     */
+    static Vector2x8 load(const Vector2* p) {
+#if defined(VECTOR2X8_AVX2)
+        const float* f = &p->x;
+        __m256 a = _mm256_loadu_ps(f);     // x0 y0 x1 y1 | x2 y2 x3 y3
+        __m256 b = _mm256_loadu_ps(f + 8); // x4 y4 x5 y5 | x6 y6 x7 y7
+        // x0 x1 x4 x5 | x2 x3 x6 x7, then swap the middle 64-bit pairs back into order
+        __m256 xs = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 ys = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        return {
+            {_mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(xs), _MM_SHUFFLE(3, 1, 2, 0)))},
+            {_mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(ys), _MM_SHUFFLE(3, 1, 2, 0)))}
+        };
+#elif defined(VECTOR2X8_SSE2)
+        const float* f = &p->x;
+        __m128 a = _mm_loadu_ps(f);
+        __m128 b = _mm_loadu_ps(f + 4);
+        __m128 c = _mm_loadu_ps(f + 8);
+        __m128 d = _mm_loadu_ps(f + 12);
+        return {
+            {_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c, d, _MM_SHUFFLE(2, 0, 2, 0))},
+            {_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c, d, _MM_SHUFFLE(3, 1, 3, 1))}
+        };
+#else
+        Vector2x8 r;
+        for (int i = 0; i < 8; ++i) {
+            r.x.v[i] = p[i].x;
+            r.y.v[i] = p[i].y;
+        }
+        return r;
+#endif
+    }
+
+    /**
+     * Loads the Vector2s at eight indices of an array.
+     */
+    static Vector2x8 gather(const Vector2* p, const int* indices) {
+        alignas(32) float xs[8];
+        alignas(32) float ys[8];
+        for (int i = 0; i < 8; ++i) {
+            xs[i] = p[indices[i]].x;
+            ys[i] = p[indices[i]].y;
+        }
+        return {Float8::load(xs), Float8::load(ys)};
+    }
+
+    static Vector2x8 broadcast(const Vector2& v) {
+        return {Float8::broadcast(v.x), Float8::broadcast(v.y)};
+    }
+
+    void store(Vector2* p) const {
+#if defined(VECTOR2X8_AVX2)
+        float* f = &p->x;
+        __m256 lo = _mm256_unpacklo_ps(x.v, y.v); // x0 y0 x1 y1 | x4 y4 x5 y5
+        __m256 hi = _mm256_unpackhi_ps(x.v, y.v); // x2 y2 x3 y3 | x6 y6 x7 y7
+        _mm256_storeu_ps(f, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(f + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+#elif defined(VECTOR2X8_SSE2)
+        float* f = &p->x;
+        _mm_storeu_ps(f, _mm_unpacklo_ps(x.lo, y.lo));
+        _mm_storeu_ps(f + 4, _mm_unpackhi_ps(x.lo, y.lo));
+        _mm_storeu_ps(f + 8, _mm_unpacklo_ps(x.hi, y.hi));
+        _mm_storeu_ps(f + 12, _mm_unpackhi_ps(x.hi, y.hi));
+#else
+        for (int i = 0; i < 8; ++i) {
+            p[i].x = x.v[i];
+            p[i].y = y.v[i];
+        }
+#endif
+    }
+
+    Vector2x8 operator-(const Vector2x8& o) const { return {x - o.x, y - o.y}; }
+
+    static Float8 dot(const Vector2x8& a, const Vector2x8& b) {
+        return a.x * b.x + a.y * b.y;
+    }
+
+    Float8 magnitudeSquared() const {
+        return dot(*this, *this);
+    }
+};
+
+/**
+ * Span versions of the VectorMath helpers, eight elements per step with a scalar tail.
+ */
+namespace VectorBatch {
+    inline void distanceSquared(const Vector2* points, std::size_t count, const Vector2& origin, float* out) {
+        Vector2x8 o = Vector2x8::broadcast(origin);
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            (Vector2x8::load(points + i) - o).magnitudeSquared().store(out + i);
+        }
+        for (; i < count; ++i) {
+            float dx = points[i].x - origin.x;
+            float dy = points[i].y - origin.y;
+            out[i] = dx * dx + dy * dy;
+        }
+    }
+
+    /**
+     * distanceSquared() for points[indices[0..count)], written to out[0..count).
+     */
+    inline void distanceSquared(const Vector2* points, const int* indices, std::size_t count, const Vector2& origin, float* out) {
+        Vector2x8 o = Vector2x8::broadcast(origin);
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            (Vector2x8::gather(points, indices + i) - o).magnitudeSquared().store(out + i);
+        }
+        for (; i < count; ++i) {
+            float dx = points[indices[i]].x - origin.x;
+            float dy = points[indices[i]].y - origin.y;
+            out[i] = dx * dx + dy * dy;
+        }
+    }
+
+    /**
+     * Writes the indices of the points strictly inside the rectangle [min, max] into outIndices.
+     * @return the number of indices written, at most count
+     */
+    inline std::size_t withinBounds(const Vector2* points, std::size_t count, const Vector2& min, const Vector2& max, int* outIndices) {
+        Vector2x8 lower = Vector2x8::broadcast(min);
+        Vector2x8 upper = Vector2x8::broadcast(max);
+        std::size_t found = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            Vector2x8 p = Vector2x8::load(points + i);
+            int bits = ((p.x > lower.x) & (p.x < upper.x) & (p.y > lower.y) & (p.y < upper.y)).maskBits();
+            for (int lane = 0; bits != 0; ++lane, bits >>= 1) {
+                if (bits & 1) outIndices[found++] = static_cast<int>(i) + lane;
+            }
+        }
+        for (; i < count; ++i) {
+            const Vector2& p = points[i];
+            if (p.x > min.x && p.x < max.x && p.y > min.y && p.y < max.y) outIndices[found++] = static_cast<int>(i);
+        }
+        return found;
+    }
+
+    /**
+     * out[i] = points[i] * scale + offset, component-wise.
+     */
+    inline void transform(const Vector2* points, std::size_t count, const Vector2& scale, const Vector2& offset, Vector2* out) {
+        Vector2x8 s = Vector2x8::broadcast(scale);
+        Vector2x8 o = Vector2x8::broadcast(offset);
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            Vector2x8 p = Vector2x8::load(points + i);
+            Vector2x8 r{p.x * s.x + o.x, p.y * s.y + o.y};
+            r.store(out + i);
+        }
+        for (; i < count; ++i) {
+            out[i] = Vector2{points[i].x * scale.x + offset.x, points[i].y * scale.y + offset.y};
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cmath>
+
+#include "Vector2.hpp"
+
+// Helper functions for Vector2
+namespace VectorMath {
+    inline Vector2 normalize(const Vector2& v) {
+        float mag = v.magnitude();
+        return (mag > 0.0001f) ? v / mag : Vector2(0, 0);
+    }
+    
+    inline float dot(const Vector2& a, const Vector2& b) {
+        return a.x * b.x + a.y * b.y;
+    }
+    
+    inline float distanceSquared(const Vector2& a, const Vector2& b) {
+        Vector2 diff = b - a;
+        return diff.x * diff.x + diff.y * diff.y;
+    }
+    
+    inline float distance(const Vector2& a, const Vector2& b) {
+        return std::sqrt(distanceSquared(a, b));
+    }
+    
+    inline Vector2 rotate(const Vector2& v, float angle) {
+        float c = std::cos(angle);
+        float s = std::sin(angle);
+        return Vector2(v.x * c - v.y * s, v.x * s + v.y * c);
+    }
+
+    /**
+     * Scales v down to maxMagnitude if it is longer, otherwise returns it unchanged.
+     */
+    inline Vector2 limit(const Vector2& v, float maxMagnitude) {
+        float mag = v.magnitude();
+        return (mag > maxMagnitude) ? normalize(v) * maxMagnitude : v;
+    }
+}
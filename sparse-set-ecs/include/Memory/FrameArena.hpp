@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+/**
+ * Bump allocator for data that lives no longer than one iteration of the main loop,
+ * e.g. neighbour lists and query results.
+ *
+ * Every thread has its own arena, see forThisThread(), so allocating takes no lock: it
+ * rounds the cursor up to the alignment and moves it past the request. Nothing is freed
+ * on its own. Application calls nextFrame() at the end of every loop iteration, and each
+ * thread's arena then starts over from the beginning the next time that thread asks for
+ * it, so the reset also happens on the owning thread.
+ *
+ * A request that doesn't fit opens another block; the next reset merges the blocks into
+ * one large enough for the whole frame, so after the first few frames the arena makes
+ * no heap allocation at all. A Scope gives the memory allocated inside it back when it
+ * ends, which keeps per-entity scratch in the same few cache lines.
+ *
+ * Nothing allocated from an arena may be kept past the end of the frame. The render
+ * thread of the pipelined mode straddles frames and must not use it.
+ */
+class FrameArena {
+public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+    static constexpr std::size_t BLOCK_ALIGNMENT = 64;
+
+    /**
+     * Gives back everything allocated from the arena between its construction and destruction.
+     */
+    class Scope {
+    private:
+        FrameArena& arena;
+        std::size_t block;
+        std::size_t base;
+        std::size_t offset;
+
+    public:
+        explicit Scope(FrameArena& arena_)
+            : arena(arena_), block(arena_.current), base(arena_.base), offset(arena_.offset) {}
+
+        ~Scope() {
+            arena.current = block;
+            arena.base = base;
+            arena.offset = offset;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    struct Block {
+        std::byte* memory;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;
+    std::size_t current = 0; // block being allocated from
+    std::size_t base = 0;    // total size of the blocks before it
+    std::size_t offset = 0;  // bytes used in it
+    std::size_t used = 0;    // furthest base + offset reached this frame
+    std::size_t peak = 0;    // largest frame so far
+    std::uint64_t frame = 0;
+
+    static inline std::atomic<std::uint64_t> s_frame = 0;
+
+    static Block allocateBlock(std::size_t size) {
+        return Block{static_cast<std::byte*>(::operator new(size, std::align_val_t{BLOCK_ALIGNMENT})), size};
+    }
+
+    static void freeBlock(const Block& block) {
+        ::operator delete(block.memory, std::align_val_t{BLOCK_ALIGNMENT});
+    }
+
+    static std::size_t alignUp(std::size_t value, std::size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // moves on to a block with room for bytes at alignment, adding one if none is left
+    void advance(std::size_t bytes, std::size_t alignment) {
+        offset = 0;
+        while (current + 1 < blocks.size()) {
+            base += blocks[current].size;
+            current++;
+            if (bytes + alignment <= blocks[current].size) {
+                return;
+            }
+        }
+
+        std::size_t size = std::max(DEFAULT_BLOCK_SIZE, alignUp(bytes + alignment, BLOCK_ALIGNMENT));
+        base += blocks[current].size;
+        blocks.push_back(allocateBlock(size));
+        current = blocks.size() - 1;
+    }
+
+public:
+    explicit FrameArena(std::size_t capacity = DEFAULT_BLOCK_SIZE) {
+        blocks.push_back(allocateBlock(alignUp(std::max<std::size_t>(capacity, BLOCK_ALIGNMENT), BLOCK_ALIGNMENT)));
+    }
+
+    ~FrameArena() {
+        for (const Block& block : blocks) {
+            freeBlock(block);
+        }
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * The calling thread's arena, reset first if a frame has ended since it was last used.
+     */
+    static FrameArena& forThisThread() {
+        thread_local FrameArena arena;
+
+        std::uint64_t frame = s_frame.load(std::memory_order_relaxed);
+        if (arena.frame != frame) {
+            arena.frame = frame;
+            arena.reset();
+        }
+        return arena;
+    }
+
+    /**
+     * Ends the frame for every thread's arena. Called by Application once per loop iteration.
+     */
+    static void nextFrame() {
+        s_frame.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        std::size_t start = alignUp(reinterpret_cast<std::uintptr_t>(blocks[current].memory) + offset, alignment)
+            - reinterpret_cast<std::uintptr_t>(blocks[current].memory);
+
+        if (start + bytes > blocks[current].size) {
+            advance(bytes, alignment);
+            start = alignUp(reinterpret_cast<std::uintptr_t>(blocks[current].memory), alignment)
+                - reinterpret_cast<std::uintptr_t>(blocks[current].memory);
+        }
+
+        offset = start + bytes;
+        used = std::max(used, base + offset);
+        return blocks[current].memory + start;
+    }
+
+    /**
+     * Takes memory back only if it is the most recent allocation, as when a vector
+     * outgrows the block it just got. Anything else waits for the reset.
+     */
+    void deallocate(void* pointer, std::size_t bytes) {
+        if (static_cast<std::byte*>(pointer) + bytes == blocks[current].memory + offset) {
+            offset -= bytes;
+        }
+    }
+
+    /**
+     * Frees everything at once. If the frame needed more than one block, they are
+     * replaced by a single block that holds all of them.
+     */
+    void reset() {
+        peak = std::max(peak, used);
+        used = 0;
+        current = 0;
+        base = 0;
+        offset = 0;
+
+        if (blocks.size() > 1) {
+            std::size_t total = 0;
+            for (const Block& block : blocks) {
+                total += block.size;
+                freeBlock(block);
+            }
+            blocks.clear();
+            blocks.push_back(allocateBlock(total));
+        }
+    }
+
+    std::size_t getCapacity() const {
+        std::size_t total = 0;
+        for (const Block& block : blocks) {
+            total += block.size;
+        }
+        return total;
+    }
+
+    /**
+     * Most bytes any finished frame took from the arena.
+     */
+    std::size_t getPeakUsage() const {
+        return peak;
+    }
+};
+
+/**
+ * STL allocator over a FrameArena. deallocate() is almost always a no-op, so reserve()
+ * what you can: every growth step of a vector leaves its old buffer behind until the reset.
+ */
+template<typename T>
+struct FrameAllocator {
+    using value_type = T;
+
+    FrameArena* arena;
+
+    FrameAllocator()
+        : arena(&FrameArena::forThisThread()) {}
+
+    explicit FrameAllocator(FrameArena& arena_)
+        : arena(&arena_) {}
+
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& other)
+        : arena(other.arena) {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t count) {
+        arena->deallocate(pointer, count * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const FrameAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
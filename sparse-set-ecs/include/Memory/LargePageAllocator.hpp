@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+#include "AllocationTracker.hpp"
+
+/**
+ * Memory for large, long-lived arrays such as component pools.
+ *
+ * Blocks of at least HUGE_PAGE_SIZE are mapped straight from the OS on Linux, start on a
+ * 2 MB boundary and are marked with madvise(MADV_HUGEPAGE), so with transparent huge pages
+ * enabled a million-entity pool is covered by a few TLB entries instead of hundreds of
+ * 4 KB ones. Smaller blocks, and every block on other platforms, come from the aligned
+ * operator new. Either way a block starts on a cache line.
+ */
+struct LargeBlocks {
+    static constexpr std::size_t CACHE_LINE = 64;
+    static constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    static std::size_t roundUp(std::size_t value, std::size_t multiple) {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+    static bool isMapped(std::size_t bytes) {
+#if defined(__linux__)
+        return bytes >= HUGE_PAGE_SIZE;
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    static void* allocate(std::size_t bytes, std::size_t alignment) {
+#if defined(__linux__)
+        if (isMapped(bytes)) {
+            std::size_t size = roundUp(bytes, HUGE_PAGE_SIZE);
+
+            // map a huge page more than needed and trim it, so the block can start on a boundary
+            void* mapped = mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapped == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            AllocationTracker::recordAllocation(size);
+
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(mapped);
+            std::uintptr_t start = roundUp(address, HUGE_PAGE_SIZE);
+            std::size_t head = start - address;
+            if (head > 0) {
+                munmap(mapped, head);
+            }
+            munmap(reinterpret_cast<void*>(start + size), HUGE_PAGE_SIZE - head);
+
+    #ifdef MADV_HUGEPAGE
+            madvise(reinterpret_cast<void*>(start), size, MADV_HUGEPAGE);
+    #endif
+            return reinterpret_cast<void*>(start);
+        }
+#endif
+        return ::operator new(bytes, std::align_val_t{std::max(alignment, CACHE_LINE)});
+    }
+
+    /**
+     * @param bytes the size that was passed to allocate()
+     */
+    static void deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+#if defined(__linux__)
+        if (isMapped(bytes)) {
+            AllocationTracker::recordFree();
+            munmap(pointer, roundUp(bytes, HUGE_PAGE_SIZE));
+            return;
+        }
+#endif
+        ::operator delete(pointer, std::align_val_t{std::max(alignment, CACHE_LINE)});
+    }
+};
+
+/**
+ * STL allocator over LargeBlocks, the default for component pools. It reports the bytes it
+ * holds to AllocationTracker::getContainerCounts().
+ */
+template<typename T>
+struct LargePageAllocator {
+    using value_type = T;
+
+    LargePageAllocator() = default;
+
+    template<typename U>
+    LargePageAllocator(const LargePageAllocator<U>&) {}
+
+    T* allocate(std::size_t count) {
+        T* pointer = static_cast<T*>(LargeBlocks::allocate(count * sizeof(T), alignof(T)));
+        AllocationTracker::recordContainerAllocation(count * sizeof(T));
+        return pointer;
+    }
+
+    void deallocate(T* pointer, std::size_t count) {
+        AllocationTracker::recordContainerFree(count * sizeof(T));
+        LargeBlocks::deallocate(pointer, count * sizeof(T), alignof(T));
+    }
+
+    template<typename U>
+    bool operator==(const LargePageAllocator<U>&) const {
+        return true;
+    }
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Counts heap allocations, fed by the global operator new/delete replacements in
+ * src/AllocationHooks.cpp.
+ *
+ * Each thread keeps its own running count and byte total, so a profile zone can take the
+ * difference over its lifetime and attribute the allocations it made. Process-wide totals
+ * are kept as well for the per-frame figures.
+ *
+ * Unless NDEBUG is defined (make RELEASE=1) a NoAllocationScope, usually via
+ * ASSERT_NO_ALLOCATIONS, makes any allocation on its thread fail an assert at the
+ * allocation itself, so the debugger stops on the offending call. That includes the
+ * default -O3 build, where the assert aborts the program.
+ */
+class AllocationTracker {
+public:
+    struct Counts {
+        std::uint64_t allocations;
+        std::uint64_t bytes;
+    };
+
+private:
+    static inline thread_local std::uint64_t t_allocations = 0;
+    static inline thread_local std::uint64_t t_bytes = 0;
+    static inline thread_local int t_forbidden = 0;
+
+    static inline std::atomic<std::uint64_t> s_allocations = 0;
+    static inline std::atomic<std::uint64_t> s_bytes = 0;
+    static inline std::atomic<std::uint64_t> s_frees = 0;
+    static inline std::atomic<bool> s_hooked = false;
+
+    static inline std::atomic<std::uint64_t> s_containerBytes = 0;
+    static inline std::atomic<std::uint64_t> s_containerAllocations = 0;
+
+public:
+    static void recordAllocation(std::size_t bytes) {
+        assert(t_forbidden == 0 && "heap allocation inside a no-allocation scope");
+
+        t_allocations++;
+        t_bytes += bytes;
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+        s_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    static void recordFree() {
+        s_frees.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Called by the hooks, so reports can tell "no allocations" from "not tracked".
+     */
+    static void markHooked() {
+        s_hooked.store(true, std::memory_order_relaxed);
+    }
+
+    static bool isHooked() {
+        return s_hooked.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Allocations made by the calling thread so far.
+     */
+    static Counts getThreadCounts() {
+        return Counts{t_allocations, t_bytes};
+    }
+
+    /**
+     * Allocations made by every thread so far.
+     */
+    static Counts getTotalCounts() {
+        return Counts{s_allocations.load(std::memory_order_relaxed), s_bytes.load(std::memory_order_relaxed)};
+    }
+
+    static std::uint64_t getFreeCount() {
+        return s_frees.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Fed by LargePageAllocator, the default allocator of component pools.
+     */
+    static void recordContainerAllocation(std::size_t bytes) {
+        s_containerBytes.fetch_add(bytes, std::memory_order_relaxed);
+        s_containerAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void recordContainerFree(std::size_t bytes) {
+        s_containerBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * Bytes currently held by containers using LargePageAllocator, and how many
+     * allocations, i.e. growth steps, they have made in total.
+     */
+    static Counts getContainerCounts() {
+        return Counts{s_containerAllocations.load(std::memory_order_relaxed), s_containerBytes.load(std::memory_order_relaxed)};
+    }
+
+    static void forbid() {
+        t_forbidden++;
+    }
+
+    static void allow() {
+        t_forbidden--;
+    }
+};
+
+/**
+ * Asserts that the calling thread makes no heap allocation while it is alive.
+ * Does nothing when NDEBUG is defined.
+ */
+class NoAllocationScope {
+public:
+#ifndef NDEBUG
+    NoAllocationScope() {
+        AllocationTracker::forbid();
+    }
+
+    ~NoAllocationScope() {
+        AllocationTracker::allow();
+    }
+#else
+    NoAllocationScope() = default;
+#endif
+
+    NoAllocationScope(const NoAllocationScope&) = delete;
+    NoAllocationScope& operator=(const NoAllocationScope&) = delete;
+};
+
+#define ALLOCATION_CONCAT_INNER(a, b) a##b
+#define ALLOCATION_CONCAT(a, b) ALLOCATION_CONCAT_INNER(a, b)
+#define ASSERT_NO_ALLOCATIONS() NoAllocationScope ALLOCATION_CONCAT(noAllocationScope, __LINE__)
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * Log-linear histogram of non-negative integer values, in the style of HdrHistogram.
+ *
+ * Values below 32 get a bucket each; above that every power of two is split into 32
+ * equal buckets, so any recorded value is known to within about 3% over the whole
+ * 64-bit range in a fixed 16 KB of counts. record() is a couple of bit operations and
+ * an increment, cheap enough to run for every zone of every frame.
+ */
+class Histogram {
+private:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr std::uint64_t SUB_BUCKETS = std::uint64_t{1} << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKET_COUNT = 64 * SUB_BUCKETS;
+
+    std::vector<std::uint64_t> counts = std::vector<std::uint64_t>(BUCKET_COUNT, 0);
+    std::uint64_t count = 0;
+    std::uint64_t min = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t max = 0;
+    double sum = 0.0;
+
+    static std::size_t indexOf(std::uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<std::size_t>(value);
+        }
+
+        int shift = std::bit_width(value) - 1 - SUB_BUCKET_BITS;
+        std::uint64_t subBucket = value >> shift; // in [SUB_BUCKETS, 2 * SUB_BUCKETS)
+        return static_cast<std::size_t>((shift + 1) * SUB_BUCKETS + subBucket - SUB_BUCKETS);
+    }
+
+    // largest value that falls in the bucket at index
+    static std::uint64_t highestValueAt(std::size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+
+        int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+        std::uint64_t subBucket = index % SUB_BUCKETS + SUB_BUCKETS;
+        return ((subBucket + 1) << shift) - 1;
+    }
+
+public:
+    void record(std::uint64_t value) {
+        counts[indexOf(value)]++;
+        count++;
+        min = std::min(min, value);
+        max = std::max(max, value);
+        sum += static_cast<double>(value);
+    }
+
+    void reset() {
+        std::fill(counts.begin(), counts.end(), 0);
+        count = 0;
+        min = std::numeric_limits<std::uint64_t>::max();
+        max = 0;
+        sum = 0.0;
+    }
+
+    /**
+     * Smallest value that at least percentile percent of the recorded values are at or below,
+     * rounded up to its bucket. 0 if nothing was recorded.
+     */
+    std::uint64_t getPercentile(double percentile) const {
+        if (count == 0) return 0;
+
+        double fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+        std::uint64_t target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(count))));
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts[i];
+            if (seen >= target) {
+                return std::clamp(highestValueAt(i), min, max);
+            }
+        }
+        return max;
+    }
+
+    std::uint64_t getCount() const {
+        return count;
+    }
+
+    std::uint64_t getMin() const {
+        return (count == 0) ? 0 : min;
+    }
+
+    std::uint64_t getMax() const {
+        return max;
+    }
+
+    double getMean() const {
+        return (count == 0) ? 0.0 : sum / static_cast<double>(count);
+    }
+};
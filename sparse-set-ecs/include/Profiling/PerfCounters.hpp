@@ -0,0 +1,172 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <cstring>
+#endif
+
+/**
+ * Hardware performance counters of the calling thread, read through perf_event_open(2)
+ * on Linux. User-space only, so it works with the default perf_event_paranoid of 2.
+ *
+ * The counters are opened as one group and sampled with a single read() call, about a
+ * microsecond each. A region is measured by difference(): when the kernel multiplexes the
+ * group, the raw counts of the region are scaled by the time it was enabled over the time
+ * it ran during that region. On other platforms, or when the counters can't be opened
+ * (no PMU in a VM, a stricter paranoid setting), open() returns false and the object
+ * stays inert.
+ */
+class PerfCounters {
+public:
+    enum Counter { Cycles, Instructions, L1DataMisses, LastLevelMisses, BranchMisses, COUNT };
+
+    using Values = std::array<std::uint64_t, COUNT>;
+
+    /**
+     * Unscaled counts and group times at one point, see sample().
+     */
+    struct Sample {
+        Values counts{};
+        std::uint64_t timeEnabled = 0;
+        std::uint64_t timeRunning = 0;
+        bool valid = false; // false if the counters weren't open or the read failed
+    };
+
+    static constexpr const char* NAMES[COUNT] = {
+        "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"
+    };
+
+private:
+    std::array<int, COUNT> fds;
+    bool open_ = false;
+
+#if defined(__linux__)
+    static int openCounter(std::uint32_t type, std::uint64_t config, int groupFd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = (groupFd == -1) ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+    }
+#endif
+
+public:
+    PerfCounters() {
+        fds.fill(-1);
+    }
+
+    ~PerfCounters() {
+        close();
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * Opens and starts the counters for the calling thread. Only that thread may read them.
+     * @return false if they aren't available, every sample is then invalid
+     */
+    bool open() {
+#if defined(__linux__)
+        if (open_) return true;
+
+        constexpr std::uint64_t L1D_READ_MISS = PERF_COUNT_HW_CACHE_L1D
+            | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+        fds[Cycles] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+        if (fds[Cycles] == -1) return false;
+
+        fds[Instructions] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, fds[Cycles]);
+        fds[L1DataMisses] = openCounter(PERF_TYPE_HW_CACHE, L1D_READ_MISS, fds[Cycles]);
+        fds[LastLevelMisses] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, fds[Cycles]);
+        fds[BranchMisses] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, fds[Cycles]);
+
+        for (int fd : fds) {
+            if (fd == -1) {
+                close();
+                return false;
+            }
+        }
+
+        ioctl(fds[Cycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds[Cycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        open_ = true;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void close() {
+#if defined(__linux__)
+        for (int& fd : fds) {
+            if (fd != -1) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+#endif
+        open_ = false;
+    }
+
+    bool isOpen() const {
+        return open_;
+    }
+
+    /**
+     * Raw counts and times since open(). Pass two samples to difference() to measure
+     * the region between them.
+     */
+    Sample sample() const {
+        Sample sample;
+#if defined(__linux__)
+        if (!open_) return sample;
+
+        // nr, time_enabled, time_running, then one value per counter in group order
+        std::uint64_t buffer[3 + COUNT];
+        if (::read(fds[Cycles], buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer))) {
+            return sample;
+        }
+
+        sample.timeEnabled = buffer[1];
+        sample.timeRunning = buffer[2];
+        for (int i = 0; i < COUNT; ++i) {
+            sample.counts[i] = buffer[3 + i];
+        }
+        sample.valid = true;
+#endif
+        return sample;
+    }
+
+    /**
+     * Counts between two samples, scaled for the share of the region the group ran.
+     * Zeros if either sample is invalid or the group never ran in between.
+     */
+    static Values difference(const Sample& start, const Sample& end) {
+        Values values{};
+        if (!start.valid || !end.valid || end.timeRunning <= start.timeRunning) {
+            return values;
+        }
+
+        double enabled = static_cast<double>(end.timeEnabled - start.timeEnabled);
+        double running = static_cast<double>(end.timeRunning - start.timeRunning);
+        for (int i = 0; i < COUNT; ++i) {
+            if (end.counts[i] > start.counts[i]) {
+                values[i] = static_cast<std::uint64_t>(static_cast<double>(end.counts[i] - start.counts[i]) * enabled / running);
+            }
+        }
+        return values;
+    }
+};
@@ -0,0 +1,651 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "AllocationTracker.hpp"
+#include "Histogram.hpp"
+#include "PerfCounters.hpp"
+
+/**
+ * Scoped CPU profiler.
+ *
+ * A ProfileZone (usually via PROFILE_ZONE) records its name, nanosecond start and end, and
+ * nesting depth into a ring buffer owned by the calling thread. Recording takes no lock:
+ * only the owning thread writes its ring, and the write position is published with a
+ * release store. Old events are overwritten once a ring is full.
+ *
+ * Application calls beginFrame()/endFrame() around every frame; endFrame() folds the events
+ * recorded since the previous frame, from every thread, into a per-zone summary, and adds
+ * the frame time and every zone's time to histograms kept for the whole run. A frame far
+ * above the median is reported as a spike, blamed on the zone that ran most over its own
+ * median. The events still held by the rings can be written out with writeChromeTrace()
+ * and opened in chrome://tracing or ui.perfetto.dev, the histograms and spikes with
+ * writeSummaryJson().
+ *
+ * With enableHardwareCounters(), every zone also records the PerfCounters deltas of its
+ * thread, and the reports add IPC and miss counts next to the times.
+ *
+ * Zones also count the heap allocations their thread made, and every frame the allocations
+ * made by all threads, when the operator new hooks of AllocationTracker are linked in.
+ *
+ * Build with -DPROFILER_DISABLED to compile every PROFILE_ZONE out.
+ */
+class Profiler {
+public:
+    struct Event {
+        const char* name;
+        std::uint64_t start; // ns since the profiler was created
+        std::uint64_t end;
+        std::uint32_t depth;
+        PerfCounters::Values counters; // zeros without hardware counters
+        std::uint64_t allocations;
+        std::uint64_t allocatedBytes;
+    };
+
+    /**
+     * Time spent in one zone over a frame, or an average frame of a report interval.
+     * Zones that run on several threads at once add up, so the time can exceed the frame.
+     */
+    struct ZoneTotal {
+        const char* name;
+        std::uint32_t depth;
+        std::uint64_t firstStart;
+        std::uint64_t time; // ns
+        std::uint64_t calls;
+        PerfCounters::Values counters;
+        std::uint64_t allocations;
+        std::uint64_t allocatedBytes;
+    };
+
+    /**
+     * A frame that took much longer than usual, and the zone that accounts for it.
+     */
+    struct Spike {
+        std::uint64_t frame;
+        std::uint64_t frameTime;   // ns
+        std::uint64_t frameMedian; // ns, over the frames before it
+        const char* zone;          // nullptr if no zone ran over its median
+        std::uint64_t zoneTime;
+        std::uint64_t zoneMedian;
+    };
+
+    static constexpr std::size_t RING_SIZE = 1 << 16;
+
+    // frames recorded before spikes are looked for, so the medians have settled
+    static constexpr std::uint64_t SPIKE_WARMUP_FRAMES = 60;
+    static constexpr std::size_t MAX_SPIKES = 256;
+
+private:
+    struct ThreadBuffer {
+        std::uint32_t threadId;
+        std::string threadName;
+        std::vector<Event> events = std::vector<Event>(RING_SIZE);
+        std::atomic<std::uint64_t> head = 0; // events ever written, the next goes to head % RING_SIZE
+        std::uint64_t summarised = 0;        // events already folded into a frame, read side only
+        std::uint32_t depth = 0;             // open zones, write side only
+        PerfCounters counters;               // write side only
+        bool countersTried = false;
+    };
+
+    using clock = std::chrono::steady_clock;
+    clock::time_point m_epoch = clock::now();
+
+    std::atomic<bool> m_enabled = true;
+    std::atomic<bool> m_countersEnabled = false;
+
+    std::mutex m_threadsMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+
+    std::uint64_t m_frameStart = 0;
+    std::vector<ZoneTotal> m_frameZones;
+    std::vector<ZoneTotal> m_intervalZones;
+    std::uint64_t m_intervalFrames = 0;
+    std::uint64_t m_intervalTime = 0;
+
+    struct ZoneHistogram {
+        const char* name;
+        std::uint32_t depth;
+        Histogram histogram;
+        PerfCounters::Values counters; // totals over the run
+        std::uint64_t allocations;
+        std::uint64_t allocatedBytes;
+    };
+
+    std::uint64_t m_frameIndex = 0;
+    Histogram m_frameHistogram;
+
+    AllocationTracker::Counts m_frameStartAllocations{};
+    Histogram m_allocationHistogram; // allocations per frame, all threads
+    std::uint64_t m_intervalAllocations = 0;
+    std::vector<ZoneHistogram> m_zoneHistograms;
+
+    // a spike is a frame over both spikeFactor times and spikeMinExcess ns above the median
+    double m_spikeFactor = 2.0;
+    std::uint64_t m_spikeMinExcess = 1'000'000;
+    std::vector<Spike> m_spikes;
+    std::uint64_t m_spikeCount = 0;
+
+    static inline thread_local ThreadBuffer* s_buffer = nullptr;
+
+    ThreadBuffer& getBuffer() {
+        if (s_buffer == nullptr) {
+            std::lock_guard lock(m_threadsMutex);
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->threadId = static_cast<std::uint32_t>(m_threads.size());
+            buffer->threadName = "Thread " + std::to_string(buffer->threadId);
+            s_buffer = buffer.get();
+            m_threads.push_back(std::move(buffer));
+        }
+        return *s_buffer;
+    }
+
+    static void addTo(std::vector<ZoneTotal>& zones, const ZoneTotal& zone) {
+        for (auto& existing : zones) {
+            if (existing.name == zone.name && existing.depth == zone.depth) {
+                existing.time += zone.time;
+                existing.calls += zone.calls;
+                existing.allocations += zone.allocations;
+                existing.allocatedBytes += zone.allocatedBytes;
+                for (int i = 0; i < PerfCounters::COUNT; ++i) {
+                    existing.counters[i] += zone.counters[i];
+                }
+                existing.firstStart = std::min(existing.firstStart, zone.firstStart);
+                return;
+            }
+        }
+        zones.push_back(zone);
+    }
+
+    ZoneHistogram* findZone(const char* name, std::uint32_t depth) {
+        for (auto& zone : m_zoneHistograms) {
+            if (zone.name == name && zone.depth == depth) {
+                return &zone;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Checks the frame just summarised in m_frameZones against the history so far.
+     * @return true if it was a spike, which is then appended to m_spikes
+     */
+    bool detectSpike(std::uint64_t frameTime) {
+        if (m_frameHistogram.getCount() < SPIKE_WARMUP_FRAMES) return false;
+
+        std::uint64_t median = m_frameHistogram.getPercentile(50.0);
+        if (static_cast<double>(frameTime) < m_spikeFactor * static_cast<double>(median)
+            || frameTime < median + m_spikeMinExcess) {
+            return false;
+        }
+
+        // how far each zone ran over its own median
+        std::uint64_t maxExcess = 0;
+        for (const auto& zone : m_frameZones) {
+            ZoneHistogram* history = findZone(zone.name, zone.depth);
+            std::uint64_t zoneMedian = history ? history->histogram.getPercentile(50.0) : 0;
+            if (zone.time > zoneMedian) {
+                maxExcess = std::max(maxExcess, zone.time - zoneMedian);
+            }
+        }
+
+        // blame the innermost zone that explains at least half of the largest overrun,
+        // so the system is named rather than the onUpdate around it
+        Spike spike{m_frameIndex, frameTime, median, nullptr, 0, 0};
+        std::uint32_t blamedDepth = 0;
+        for (const auto& zone : m_frameZones) {
+            ZoneHistogram* history = findZone(zone.name, zone.depth);
+            std::uint64_t zoneMedian = history ? history->histogram.getPercentile(50.0) : 0;
+            std::uint64_t excess = (zone.time > zoneMedian) ? zone.time - zoneMedian : 0;
+
+            if (maxExcess > 0 && excess * 2 >= maxExcess && (spike.zone == nullptr || zone.depth > blamedDepth)) {
+                spike.zone = zone.name;
+                spike.zoneTime = zone.time;
+                spike.zoneMedian = zoneMedian;
+                blamedDepth = zone.depth;
+            }
+        }
+
+        m_spikeCount++;
+        if (m_spikes.size() < MAX_SPIKES) {
+            m_spikes.push_back(spike);
+        }
+        return true;
+    }
+
+    /**
+     * Appends the per-frame counter averages of a zone, e.g. " | IPC 1.52, 120 L1D, 3 LLC, 40 branch misses".
+     */
+    static void writeCounters(std::ostream& out, const PerfCounters::Values& counters, double frames) {
+        if (counters[PerfCounters::Cycles] == 0) return;
+
+        double ipc = static_cast<double>(counters[PerfCounters::Instructions]) / static_cast<double>(counters[PerfCounters::Cycles]);
+        out << " | IPC " << ipc
+            << ", " << static_cast<double>(counters[PerfCounters::L1DataMisses]) / frames << " L1D"
+            << ", " << static_cast<double>(counters[PerfCounters::LastLevelMisses]) / frames << " LLC"
+            << ", " << static_cast<double>(counters[PerfCounters::BranchMisses]) / frames << " branch misses";
+    }
+
+    static void writeEscaped(std::ostream& out, const std::string& text) {
+        for (char c : text) {
+            if (c == '"' || c == '\\') out << '\\';
+            out << c;
+        }
+    }
+
+public:
+    Profiler() = default;
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static Profiler& getInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    std::uint64_t now() const {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - m_epoch).count()
+        );
+    }
+
+    bool isEnabled() const {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool enabled) {
+        m_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * Names the calling thread in traces.
+     */
+    void setThreadName(const std::string& name) {
+        ThreadBuffer& buffer = getBuffer();
+        std::lock_guard lock(m_threadsMutex);
+        buffer.threadName = name;
+    }
+
+    /**
+     * Samples hardware counters in every zone from now on, on each thread that manages to
+     * open them. The calling thread's are opened straight away.
+     * @return false if they aren't available on the calling thread, nothing is sampled then
+     */
+    bool enableHardwareCounters() {
+        ThreadBuffer& buffer = getBuffer();
+        buffer.countersTried = true;
+        if (!buffer.counters.open()) {
+            return false;
+        }
+
+        m_countersEnabled.store(true, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool hasHardwareCounters() const {
+        return m_countersEnabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Opens a zone on the calling thread.
+     * @param startCounters receives the thread's counters at the start of the zone
+     * @return the nesting depth of the zone, to be passed back to endZone()
+     */
+    std::uint32_t beginZone(PerfCounters::Sample& startCounters, AllocationTracker::Counts& startAllocations) {
+        ThreadBuffer& buffer = getBuffer();
+
+        if (m_countersEnabled.load(std::memory_order_relaxed)) {
+            if (!buffer.countersTried) {
+                buffer.countersTried = true;
+                buffer.counters.open();
+            }
+            startCounters = buffer.counters.sample();
+        }
+
+        startAllocations = AllocationTracker::getThreadCounts();
+        return buffer.depth++;
+    }
+
+    void endZone(const char* name, std::uint64_t start, std::uint32_t depth,
+                 const PerfCounters::Sample& startCounters, const AllocationTracker::Counts& startAllocations) {
+        std::uint64_t end = now();
+        AllocationTracker::Counts allocations = AllocationTracker::getThreadCounts();
+        ThreadBuffer& buffer = getBuffer();
+        buffer.depth = depth;
+
+        PerfCounters::Values counters{};
+        if (buffer.counters.isOpen()) {
+            counters = PerfCounters::difference(startCounters, buffer.counters.sample());
+        }
+
+        std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+        buffer.events[head % RING_SIZE] = Event{
+            name, start, end, depth, counters,
+            allocations.allocations - startAllocations.allocations, allocations.bytes - startAllocations.bytes
+        };
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+    void beginFrame() {
+        m_frameStart = now();
+        m_frameStartAllocations = AllocationTracker::getTotalCounts();
+    }
+
+    /**
+     * Frames count as spikes when they take more than factor times the median frame time
+     * and at least minExcess ns more than it.
+     */
+    void setSpikeThreshold(double factor, std::uint64_t minExcess) {
+        m_spikeFactor = factor;
+        m_spikeMinExcess = minExcess;
+    }
+
+    /**
+     * Summarises the events finished since the previous endFrame() on every thread.
+     * @return true if the frame was a spike, see getSpikes()
+     */
+    bool endFrame() {
+        std::uint64_t frameEnd = now();
+        std::uint64_t frameAllocations = AllocationTracker::getTotalCounts().allocations - m_frameStartAllocations.allocations;
+        m_frameZones.clear();
+
+        {
+            std::lock_guard lock(m_threadsMutex);
+            for (auto& buffer : m_threads) {
+                std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+                std::uint64_t begin = std::max(buffer->summarised, head > RING_SIZE ? head - RING_SIZE : 0);
+
+                for (std::uint64_t i = begin; i < head; ++i) {
+                    const Event& event = buffer->events[i % RING_SIZE];
+                    addTo(m_frameZones, ZoneTotal{
+                        event.name, event.depth, event.start, event.end - event.start, 1,
+                        event.counters, event.allocations, event.allocatedBytes
+                    });
+                }
+                buffer->summarised = head;
+            }
+        }
+
+        std::sort(m_frameZones.begin(), m_frameZones.end(), [](const ZoneTotal& a, const ZoneTotal& b) {
+            return a.firstStart < b.firstStart;
+        });
+
+        for (const auto& zone : m_frameZones) {
+            addTo(m_intervalZones, zone);
+        }
+        std::uint64_t frameTime = frameEnd - m_frameStart;
+        m_intervalFrames++;
+        m_intervalTime += frameTime;
+        m_intervalAllocations += frameAllocations;
+
+        bool spike = detectSpike(frameTime);
+
+        m_frameHistogram.record(frameTime);
+        m_allocationHistogram.record(frameAllocations);
+        for (const auto& zone : m_frameZones) {
+            ZoneHistogram* history = findZone(zone.name, zone.depth);
+            if (history == nullptr) {
+                m_zoneHistograms.push_back(ZoneHistogram{zone.name, zone.depth, Histogram{}, {}, 0, 0});
+                history = &m_zoneHistograms.back();
+            }
+
+            history->histogram.record(zone.time);
+            for (int i = 0; i < PerfCounters::COUNT; ++i) {
+                history->counters[i] += zone.counters[i];
+            }
+            history->allocations += zone.allocations;
+            history->allocatedBytes += zone.allocatedBytes;
+        }
+
+        m_frameIndex++;
+        return spike;
+    }
+
+    /**
+     * Zones of the last finished frame, in the order they first started.
+     */
+    const std::vector<ZoneTotal>& getFrameSummary() const {
+        return m_frameZones;
+    }
+
+    std::uint64_t getIntervalFrameCount() const {
+        return m_intervalFrames;
+    }
+
+    const Histogram& getFrameHistogram() const {
+        return m_frameHistogram;
+    }
+
+    /**
+     * Heap allocations made per frame by every thread. All zeros unless
+     * AllocationTracker::isHooked().
+     */
+    const Histogram& getAllocationHistogram() const {
+        return m_allocationHistogram;
+    }
+
+    /**
+     * The first MAX_SPIKES spikes of the run, getSpikeCount() counts them all.
+     */
+    const std::vector<Spike>& getSpikes() const {
+        return m_spikes;
+    }
+
+    std::uint64_t getSpikeCount() const {
+        return m_spikeCount;
+    }
+
+    /**
+     * Prints the frame rate and the average time per frame of every zone since the last
+     * report, indented by nesting depth, and starts a new interval. With hardware counters
+     * the zone's IPC and misses per frame follow, and zones that allocated get their
+     * allocations per frame.
+     */
+    void reportInterval(std::ostream& out) {
+        if (m_intervalFrames == 0) return;
+
+        std::ios_base::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::fixed << std::setprecision(3);
+
+        double frames = static_cast<double>(m_intervalFrames);
+        double frameTime = static_cast<double>(m_intervalTime) / frames;
+        out << "FPS: " << 1e9 / frameTime << " (" << frameTime / 1e6 << " ms per frame";
+        if (AllocationTracker::isHooked()) {
+            out << ", " << static_cast<double>(m_intervalAllocations) / frames << " allocations";
+        }
+        out << ")\n";
+
+        std::sort(m_intervalZones.begin(), m_intervalZones.end(), [](const ZoneTotal& a, const ZoneTotal& b) {
+            return a.firstStart < b.firstStart;
+        });
+        for (const auto& zone : m_intervalZones) {
+            out << "  " << std::string(zone.depth * 2, ' ') << zone.name << ": "
+                << static_cast<double>(zone.time) / frames / 1e6 << " ms";
+            if (zone.calls > m_intervalFrames) {
+                out << " (" << static_cast<double>(zone.calls) / frames << " calls)";
+            }
+            writeCounters(out, zone.counters, frames);
+            if (zone.allocations > 0) {
+                out << " | " << static_cast<double>(zone.allocations) / frames << " allocations, "
+                    << static_cast<double>(zone.allocatedBytes) / frames << " bytes";
+            }
+            out << '\n';
+        }
+        out.flags(flags);
+        out.precision(precision);
+
+        m_intervalZones.clear();
+        m_intervalFrames = 0;
+        m_intervalTime = 0;
+        m_intervalAllocations = 0;
+    }
+
+    /**
+     * Writes the frame time and per-zone histograms of the whole run, as p50/p95/p99/max
+     * and mean in milliseconds, and the spikes as JSON. Zones with hardware counters also
+     * get their counts averaged over the frames they ran in, likewise their allocations.
+     * With the allocation hooks linked in, the allocations per frame are added too.
+     * @return false if the file cannot be opened
+     */
+    bool writeSummaryJson(const std::string& path) const {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) return false;
+
+        auto ms = [](double ns) { return ns / 1e6; };
+        auto writeStats = [&](const Histogram& histogram) {
+            out << "\"count\":" << histogram.getCount()
+                << ",\"mean_ms\":" << ms(histogram.getMean())
+                << ",\"p50_ms\":" << ms(static_cast<double>(histogram.getPercentile(50.0)))
+                << ",\"p95_ms\":" << ms(static_cast<double>(histogram.getPercentile(95.0)))
+                << ",\"p99_ms\":" << ms(static_cast<double>(histogram.getPercentile(99.0)))
+                << ",\"max_ms\":" << ms(static_cast<double>(histogram.getMax()));
+        };
+
+        out << "{\n\"frames\":{";
+        writeStats(m_frameHistogram);
+        out << '}';
+        if (AllocationTracker::isHooked()) {
+            out << ",\n\"allocations_per_frame\":{\"mean\":" << m_allocationHistogram.getMean()
+                << ",\"p50\":" << m_allocationHistogram.getPercentile(50.0)
+                << ",\"p99\":" << m_allocationHistogram.getPercentile(99.0)
+                << ",\"max\":" << m_allocationHistogram.getMax() << '}';
+        }
+        out << ",\n\"zones\":[";
+
+        for (std::size_t i = 0; i < m_zoneHistograms.size(); ++i) {
+            const auto& zone = m_zoneHistograms[i];
+            out << (i == 0 ? "\n" : ",\n") << "{\"name\":\"";
+            writeEscaped(out, zone.name);
+            out << "\",\"depth\":" << zone.depth << ',';
+            writeStats(zone.histogram);
+
+            // per frame the zone ran in
+            if (zone.counters[PerfCounters::Cycles] > 0) {
+                double frames = static_cast<double>(zone.histogram.getCount());
+                out << ",\"counters\":{";
+                for (int c = 0; c < PerfCounters::COUNT; ++c) {
+                    out << (c == 0 ? "" : ",") << '"' << PerfCounters::NAMES[c] << "\":"
+                        << static_cast<double>(zone.counters[c]) / frames;
+                }
+                out << '}';
+            }
+            if (zone.allocations > 0) {
+                double frames = static_cast<double>(zone.histogram.getCount());
+                out << ",\"allocations\":" << static_cast<double>(zone.allocations) / frames
+                    << ",\"allocated_bytes\":" << static_cast<double>(zone.allocatedBytes) / frames;
+            }
+            out << '}';
+        }
+
+        out << "\n],\n\"spike_count\":" << m_spikeCount << ",\n\"spikes\":[";
+        for (std::size_t i = 0; i < m_spikes.size(); ++i) {
+            const Spike& spike = m_spikes[i];
+            out << (i == 0 ? "\n" : ",\n")
+                << "{\"frame\":" << spike.frame
+                << ",\"frame_ms\":" << ms(static_cast<double>(spike.frameTime))
+                << ",\"frame_median_ms\":" << ms(static_cast<double>(spike.frameMedian))
+                << ",\"zone\":";
+            if (spike.zone) {
+                out << '"';
+                writeEscaped(out, spike.zone);
+                out << '"';
+            } else {
+                out << "null";
+            }
+            out << ",\"zone_ms\":" << ms(static_cast<double>(spike.zoneTime))
+                << ",\"zone_median_ms\":" << ms(static_cast<double>(spike.zoneMedian)) << '}';
+        }
+
+        out << "\n]\n}\n";
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * Writes the events still held by the rings as Chrome trace JSON.
+     * Call while no zones are being recorded.
+     * @return false if the file cannot be opened
+     */
+    bool writeChromeTrace(const std::string& path) {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) return false;
+
+        std::lock_guard lock(m_threadsMutex);
+        out << "{\"traceEvents\":[\n";
+        bool first = true;
+
+        for (const auto& buffer : m_threads) {
+            out << (first ? "" : ",\n")
+                << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->threadId
+                << ",\"args\":{\"name\":\"";
+            writeEscaped(out, buffer->threadName);
+            out << "\"}}";
+            first = false;
+
+            std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+            std::uint64_t begin = head > RING_SIZE ? head - RING_SIZE : 0;
+            for (std::uint64_t i = begin; i < head; ++i) {
+                const Event& event = buffer->events[i % RING_SIZE];
+                out << ",\n{\"name\":\"";
+                writeEscaped(out, event.name);
+                out << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->threadId
+                    << ",\"ts\":" << static_cast<double>(event.start) / 1e3
+                    << ",\"dur\":" << static_cast<double>(event.end - event.start) / 1e3 << '}';
+            }
+        }
+
+        out << "\n]}\n";
+        return static_cast<bool>(out);
+    }
+};
+
+/**
+ * Records the time between its construction and destruction as a zone named name.
+ * name must outlive the profiler, in practice a string literal.
+ */
+class ProfileZone {
+private:
+    const char* name;
+    std::uint64_t start;
+    std::uint32_t depth;
+    bool active;
+    PerfCounters::Sample startCounters;
+    AllocationTracker::Counts startAllocations{};
+
+public:
+    explicit ProfileZone(const char* name_)
+        : name(name_), start(0), depth(0), active(Profiler::getInstance().isEnabled())
+    {
+        if (active) {
+            depth = Profiler::getInstance().beginZone(startCounters, startAllocations);
+            start = Profiler::getInstance().now();
+        }
+    }
+
+    ~ProfileZone() {
+        if (active) {
+            Profiler::getInstance().endZone(name, start, depth, startCounters, startAllocations);
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifndef PROFILER_DISABLED
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
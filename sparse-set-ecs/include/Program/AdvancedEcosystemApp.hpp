@@ -2,139 +2,37 @@
 
 #include "Application.hpp"
 #include "IRenderer.hpp"
+#include "RenderCommandList.hpp"
 #include "Vector2.hpp"
+#include "VectorMath.hpp"
+#include "Vector2x8.hpp"
+#include "Random.hpp"
+#include "ThreadPool.hpp"
+#include "Profiler.hpp"
+#include "FrameArena.hpp"
+
+#include "EntityComponentManager.hpp"
+#include "EntityWrapper.hpp"
+#include "KinematicsComponent.hpp"
+#include "SteeringComponent.hpp"
+#include "EnergyComponent.hpp"
+#include "SpeciesComponent.hpp"
+#include "RenderStyleComponent.hpp"
+#include "GenesComponent.hpp"
+#include "LifecycleComponent.hpp"
+#include "SimulationLodComponent.hpp"
+#include "FlockSnapshot.hpp"
+#include "FlockCellAggregates.hpp"
+#include "SpeciesPartition.hpp"
+#include "KinematicsSystem.hpp"
+#include "SimulationLodSystem.hpp"
+#include "ViewCullingSystem.hpp"
+
 #include <vector>
-#include <random>
 #include <cmath>
 #include <algorithm>
 #include <memory>
 
-// Helper functions for Vector2
-namespace VectorMath {
-    inline Vector2 normalize(const Vector2& v) {
-        float mag = v.magnitude();
-        return (mag > 0.0001f) ? v / mag : Vector2(0, 0);
-    }
-    
-    inline float dot(const Vector2& a, const Vector2& b) {
-        return a.x * b.x + a.y * b.y;
-    }
-    
-    inline float distanceSquared(const Vector2& a, const Vector2& b) {
-        Vector2 diff = b - a;
-        return diff.x * diff.x + diff.y * diff.y;
-    }
-    
-    inline float distance(const Vector2& a, const Vector2& b) {
-        return std::sqrt(distanceSquared(a, b));
-    }
-    
-    inline Vector2 rotate(const Vector2& v, float angle) {
-        float c = std::cos(angle);
-        float s = std::sin(angle);
-        return Vector2(v.x * c - v.y * s, v.x * s + v.y * c);
-    }
-}
-
-// Genetic traits for evolution
-struct Genes {
-    float maxSpeed;
-    float perceptionRadius;
-    float aggression;
-    float fearResponse;
-    float metabolism;
-    float reproductionThreshold;
-    
-    Genes() : maxSpeed(150.0f), perceptionRadius(50.0f), aggression(0.5f),
-              fearResponse(0.5f), metabolism(1.0f), reproductionThreshold(80.0f) {}
-    
-    Genes mutate(std::mt19937& rng) const {
-        std::uniform_real_distribution<float> mutationDist(-0.1f, 0.1f);
-        Genes child = *this;
-        child.maxSpeed += mutationDist(rng) * 30.0f;
-        child.perceptionRadius += mutationDist(rng) * 10.0f;
-        child.aggression += mutationDist(rng) * 0.2f;
-        child.fearResponse += mutationDist(rng) * 0.2f;
-        child.metabolism += mutationDist(rng) * 0.2f;
-        child.reproductionThreshold += mutationDist(rng) * 10.0f;
-        
-        // Clamp values
-        child.maxSpeed = std::max(50.0f, std::min(250.0f, child.maxSpeed));
-        child.perceptionRadius = std::max(20.0f, std::min(100.0f, child.perceptionRadius));
-        child.aggression = std::max(0.0f, std::min(1.0f, child.aggression));
-        child.fearResponse = std::max(0.0f, std::min(1.0f, child.fearResponse));
-        child.metabolism = std::max(0.5f, std::min(2.0f, child.metabolism));
-        child.reproductionThreshold = std::max(60.0f, std::min(95.0f, child.reproductionThreshold));
-        
-        return child;
-    }
-};
-
-struct Boid {
-    Vector2 position;
-    Vector2 velocity;
-    Vector2 acceleration;
-    Color color;
-    float maxForce;
-    int type; // 0=herbivore, 1=carnivore, 2=omnivore, 3=scavenger
-    float energy;
-    float health;
-    bool isDead;
-    int generation;
-    Genes genes;
-    float reproductionCooldown;
-    int age; // in frames
-    bool isChild;
-    
-    Boid(Vector2 pos, Vector2 vel, Color col, int t, int gen = 0)
-        : position(pos), velocity(vel), acceleration(0, 0), color(col),
-          maxForce(0.5f), type(t), energy(100.0f), health(100.0f),
-          isDead(false), generation(gen), reproductionCooldown(0.0f),
-          age(0), isChild(true) {}
-    
-    void applyForce(const Vector2& force) {
-        acceleration += force;
-    }
-    
-    void update(float dt) {
-        velocity += acceleration * dt;
-        
-        // Limit velocity based on genes
-        float speed = velocity.magnitude();
-        if (speed > genes.maxSpeed) {
-            velocity = VectorMath::normalize(velocity) * genes.maxSpeed;
-        }
-        
-        position += velocity * dt;
-        acceleration *= 0.0f;
-        
-        // Energy consumption based on metabolism and speed
-        float movementCost = (speed / genes.maxSpeed) * genes.metabolism;
-        energy -= dt * (1.0f + movementCost);
-        
-        // Age the boid
-        age++;
-        if (age > 1800) { // 30 seconds at 60fps
-            isChild = false;
-        }
-        
-        // Reproduction cooldown
-        if (reproductionCooldown > 0.0f) {
-            reproductionCooldown -= dt;
-        }
-        
-        // Health deterioration when energy is low
-        if (energy <= 0.0f) {
-            health -= dt * 10.0f;
-            if (health <= 0.0f) {
-                isDead = true;
-            }
-        } else if (energy > 50.0f && health < 100.0f) {
-            health += dt * 5.0f; // Regenerate health
-        }
-    }
-};
-
 struct Food {
     Vector2 position;
     float radius;
@@ -171,21 +69,20 @@ struct WeatherSystem {
     WeatherSystem() : windStrength(0.0f), windDirection(1, 0), 
                       temperature(20.0f), isRaining(false), dayNightCycle(0.5f) {}
     
-    void update(float dt, std::mt19937& rng) {
+    void update(float dt, RandomStream& rng) {
         dayNightCycle += dt * 0.05f;
         if (dayNightCycle > 1.0f) dayNightCycle = 0.0f;
         
         // Random weather changes
-        std::uniform_real_distribution<float> chanceDist(0.0f, 1.0f);
-        if (chanceDist(rng) < 0.001f) {
+        if (rng.chance(0.001f)) {
             isRaining = !isRaining;
         }
         
         // Wind changes
-        windStrength += (chanceDist(rng) - 0.5f) * 0.1f;
+        windStrength += (rng.nextFloat() - 0.5f) * 0.1f;
         windStrength = std::max(0.0f, std::min(30.0f, windStrength));
         
-        float angleChange = (chanceDist(rng) - 0.5f) * 0.1f;
+        float angleChange = (rng.nextFloat() - 0.5f) * 0.1f;
         windDirection = VectorMath::rotate(windDirection, angleChange);
         windDirection = VectorMath::normalize(windDirection);
         
@@ -230,52 +127,134 @@ struct SpatialGrid {
         }
     }
     
-    std::vector<int> query(const Vector2& pos, float radius) {
-        std::vector<int> result;
+    /**
+     * Fills result with the indices in the cells overlapping the square around pos.
+     * The cells are counted first so result grows at most once, which matters for a
+     * vector in a FrameArena where every growth step leaves its old buffer behind.
+     */
+    void query(const Vector2& pos, float radius, FrameVector<int>& result) const {
+        result.clear();
         int minX = std::max(0, static_cast<int>((pos.x - radius) / CELL_SIZE));
         int maxX = std::min(width - 1, static_cast<int>((pos.x + radius) / CELL_SIZE));
         int minY = std::max(0, static_cast<int>((pos.y - radius) / CELL_SIZE));
         int maxY = std::min(height - 1, static_cast<int>((pos.y + radius) / CELL_SIZE));
         
+        std::size_t total = 0;
+        for (int y = minY; y <= maxY; ++y) {
+            for (int x = minX; x <= maxX; ++x) {
+                total += grid[y * width + x].size();
+            }
+        }
+        result.reserve(total);
+        
         for (int y = minY; y <= maxY; ++y) {
             for (int x = minX; x <= maxX; ++x) {
                 const auto& cell = grid[y * width + x];
                 result.insert(result.end(), cell.begin(), cell.end());
             }
         }
-        return result;
     }
 };
 
+/**
+ * Boids are entities whose data is split by how often it is touched:
+ *  - hot, read by every neighbour scan:
+ *      KinematicsComponent (position, velocity), SpeciesComponent
+ *      (0=herbivore, 1=carnivore, 2=omnivore, 3=scavenger)
+ *  - read once per boid per frame:
+ *      SteeringComponent, EnergyComponent, RenderStyleComponent, SimulationLodComponent
+ *  - cold, only read by the life cycle and genetics passes:
+ *      GenesComponent, LifecycleComponent
+ */
 class AdvancedEcosystemApp : public Application {
 private:
-    std::vector<Boid> m_boids;
+    EntityComponentManager& ecm = EntityComponentManager::getInstance();
+    ThreadPool& m_threadPool = ThreadPool::getInstance();
+
+    // read side of the steering pass, grid cells hold snapshot indices
+    FlockSnapshot m_snapshot;
+    FlockCellAggregates m_cellAggregates;
+    SpeciesPartition m_partition;
+
     std::vector<Food> m_food;
     std::vector<Obstacle> m_obstacles;
-    std::mt19937 m_rng;
+
+    // recorded in onRender and drawn in one submit, reused every frame
+    RenderCommandList m_renderCommands;
+    std::vector<Vector2> m_renderPositions; // scratch for viewCullingSystem
+    std::vector<int> m_visibleBoids;
+
+    // 0 picks a new seed every run, the seed in use is printed on start
+    const std::uint64_t RANDOM_SEED = 0;
+    RandomSource m_random;
+    RandomStream m_rng; // main thread only
     SpatialGrid m_spatialGrid;
     WeatherSystem m_weather;
-    
+
     const float WORLD_WIDTH = 1600.0f;
     const float WORLD_HEIGHT = 1000.0f;
     const size_t MAX_BOIDS = 300;
+
+    // Boids further than this outside the camera are not drawn. Covers the longest line
+    // drawn from a boid (camera units) and the largest boid radius (pixels).
+    const float CULL_MARGIN = 60.0f;
+    const float CULL_PIXEL_MARGIN = 10.0f;
     const size_t MAX_FOOD = 150;
-    
+
     // Flocking parameters
     const float ALIGNMENT_WEIGHT = 0.8f;
     const float COHESION_WEIGHT = 0.8f;
     const float SEPARATION_WEIGHT = 1.5f;
     const float SEPARATION_DISTANCE = 25.0f;
+    const float FLEE_RADIUS = 150.0f;
+    const float HUNT_RADIUS = 300.0f;
+    
+    /**
+     * Species-specific steering on top of flocking. A zero weight skips that behaviour.
+     * Boids are steered one species range at a time, so these checks are the same for a whole batch.
+     */
+    struct Behaviour {
+        float seekFood;
+        int foodType; // 0=plant, 1=meat, -1=any
+        float flee;   // scaled by the fearResponse gene
+        float hunt;   // scaled by the aggression gene
+    };
+    
+    static constexpr int SPECIES_COUNT = 4;
     
+    // indexed by species: herbivore, carnivore, omnivore, scavenger
+    const Behaviour BEHAVIOURS[SPECIES_COUNT] = {
+        {1.5f, 0, 3.0f, 0.0f},
+        {0.0f, 0, 0.0f, 2.0f},
+        {1.2f, -1, 2.0f, 0.0f},
+        {1.8f, 1, 0.0f, 0.0f}
+    };
+    
+    // Approximate alignment and cohesion from per-cell sums instead of visiting every flockmate.
+    // Smaller cells follow the perception radius more closely at a higher per-boid cost.
+    const bool APPROXIMATE_FLOCKING = false;
+    const float AGGREGATE_CELL_SIZE = 25.0f;
+
+    // Time-sliced level of detail: idle boids, or boids far outside the camera, only run
+    // their behaviour every 2^tier frames and apply the accumulated time when they do.
+    const bool SIMULATION_LOD = false;
+    const float LOD_TIER_DISTANCE = 200.0f;
+    const int LOD_IDLE_TIER = 1;
+    const int LOD_MAX_TIER = 3;
+    const float LOD_ACTIVE_TIME = 1.0f; // seconds at full rate after an interaction
+    const float LOD_ALERT_RADIUS = 150.0f;
+    
+    const size_t BOIDS_PER_TASK = 16;
+
     float m_globalTime = 0.0f;
     float m_foodSpawnTimer = 0.0f;
     int m_frameCounter = 0;
-    
+
     // Stats
     int m_totalBirths = 0;
     int m_totalDeaths = 0;
     int m_generationMax = 0;
-    
+
     // Ecosystem zones
     struct Zone {
         Vector2 center;
@@ -284,19 +263,43 @@ private:
     };
     std::vector<Zone> m_zones;
 
+    // Children created by handleReproduction, spawned once the pools are no longer being iterated
+    struct Birth {
+        Vector2 position;
+        Vector2 velocity;
+        Color color;
+        int type;
+        int generation;
+        GenesComponent genes;
+    };
+    std::vector<Birth> m_births;
+
 public:
     explicit AdvancedEcosystemApp(std::unique_ptr<ICore> core)
-        : Application(std::move(core)), m_rng(std::random_device{}()) {}
+        : Application(std::move(core)), m_random(RANDOM_SEED), m_rng(m_random.stream(RandomSource::Purpose::Main)) {}
 
     bool onStart() override {
         std::cout << "=== Advanced Ecosystem Simulation ===\n";
         std::cout << "Features: Genetics, Evolution, Weather, Biomes\n";
+        std::cout << "Random seed: " << m_random.getSeed() << "\n";
         
         getRenderer().setCameraSpace(WORLD_HEIGHT, 0, 0, WORLD_WIDTH);
         
-        m_boids.reserve(MAX_BOIDS);
         m_food.reserve(MAX_FOOD);
         m_spatialGrid.initialize(WORLD_WIDTH, WORLD_HEIGHT);
+        m_cellAggregates.initialize(WORLD_WIDTH, WORLD_HEIGHT, AGGREGATE_CELL_SIZE, SPECIES_COUNT);
+        m_partition.initialize(SPECIES_COUNT);
+        
+        // every boid has these, so their pools are sized for the largest population once
+        ecm.reserveEntities(MAX_BOIDS);
+        ecm.reserveComponents<KinematicsComponent>(MAX_BOIDS);
+        ecm.reserveComponents<SpeciesComponent>(MAX_BOIDS);
+        ecm.reserveComponents<SteeringComponent>(MAX_BOIDS);
+        ecm.reserveComponents<EnergyComponent>(MAX_BOIDS);
+        ecm.reserveComponents<RenderStyleComponent>(MAX_BOIDS);
+        ecm.reserveComponents<GenesComponent>(MAX_BOIDS);
+        ecm.reserveComponents<LifecycleComponent>(MAX_BOIDS);
+        ecm.reserveComponents<SimulationLodComponent>(MAX_BOIDS);
         
         // Create biome zones
         createZones();
@@ -313,7 +316,7 @@ public:
         // Spawn initial food
         for (int i = 0; i < 50; ++i) spawnFood(0);
         
-        std::cout << "Initial population: " << m_boids.size() << "\n";
+        std::cout << "Initial population: " << ecm.getPool<KinematicsComponent>().getSize() << "\n";
         std::cout << "Biomes: " << m_zones.size() << "\n";
         std::cout << "Simulation started!\n";
         
@@ -325,25 +328,30 @@ public:
         std::cout << "Total births: " << m_totalBirths << "\n";
         std::cout << "Total deaths: " << m_totalDeaths << "\n";
         std::cout << "Max generation reached: " << m_generationMax << "\n";
-        std::cout << "Final population: " << m_boids.size() << "\n";
+        std::cout << "Final population: " << ecm.getPool<KinematicsComponent>().getSize() << "\n";
     }
 
     void onUpdate(float dt) override {
-        dt = std::min(dt, 0.1f);
-        
         m_frameCounter++;
         m_globalTime += dt;
         m_foodSpawnTimer += dt;
         
+        auto& kinematicsPool = ecm.getPool<KinematicsComponent>();
+        auto& steeringPool = ecm.getPool<SteeringComponent>();
+        auto& speciesPool = ecm.getPool<SpeciesComponent>();
+        
         // Update weather
         m_weather.update(dt, m_rng);
         
-        // Rebuild spatial grid
+        // Group boids by species, snapshot hot data and rebuild spatial grid
+        m_partition.update(kinematicsPool, speciesPool);
+        m_snapshot.capture(kinematicsPool, speciesPool);
         m_spatialGrid.clear();
-        for (size_t i = 0; i < m_boids.size(); ++i) {
-            if (!m_boids[i].isDead) {
-                m_spatialGrid.insert(m_boids[i].position, i);
-            }
+        for (size_t i = 0; i < m_snapshot.getSize(); ++i) {
+            m_spatialGrid.insert(m_snapshot.positions[i], i);
+        }
+        if (APPROXIMATE_FLOCKING) {
+            m_cellAggregates.build(m_snapshot);
         }
         
         // Spawn food based on biomes
@@ -357,34 +365,27 @@ public:
         }
         
         // Update all boids
-        for (size_t i = 0; i < m_boids.size(); ++i) {
-            if (m_boids[i].isDead) continue;
-            
-            updateBoidBehavior(i, dt);
-            m_boids[i].update(dt);
-            wrapBoid(m_boids[i]);
+        if (SIMULATION_LOD) {
+            simulationLodSystem(ecm.getPool<SimulationLodComponent>(), kinematicsPool, getLodPolicy(), m_frameCounter, dt);
         }
+        steeringSystem(kinematicsPool, steeringPool, dt);
+        kinematicsSystem(kinematicsPool, steeringPool, dt);
+        worldWrapSystem(kinematicsPool, WORLD_WIDTH, WORLD_HEIGHT);
+        lifecycleSystem(dt);
         
         // Handle interactions
         handleFoodConsumption();
         handlePredation();
         handleReproduction();
         
-        // Create corpses from dead boids
-        for (const auto& boid : m_boids) {
-            if (boid.isDead && !boid.isChild && m_food.size() < MAX_FOOD) {
-                m_food.emplace_back(boid.position, 1); // Meat
-            }
-        }
+        // Create corpses from dead boids and queue them for deletion
+        removeDeadBoids();
+        ecm.deleteEntities();
         
-        // Remove dead entities
-        size_t beforeCount = m_boids.size();
-        m_boids.erase(
-            std::remove_if(m_boids.begin(), m_boids.end(),
-                [](const Boid& b) { return b.isDead; }),
-            m_boids.end()
-        );
-        m_totalDeaths += (beforeCount - m_boids.size());
+        for (const auto& birth : m_births) {
+            spawnChild(birth);
+        }
+        m_births.clear();
         
         m_food.erase(
             std::remove_if(m_food.begin(), m_food.end(),
@@ -401,6 +402,12 @@ public:
     void onRender() override {
         IRenderer& renderer = getRenderer();
         
+        auto& kinematicsPool = ecm.getPool<KinematicsComponent>();
+        auto& speciesPool = ecm.getPool<SpeciesComponent>();
+        auto& energyPool = ecm.getPool<EnergyComponent>();
+        auto& renderStylePool = ecm.getPool<RenderStyleComponent>();
+        auto& lifecyclePool = ecm.getPool<LifecycleComponent>();
+        
         // Day/night cycle background
         float dayBrightness = 0.5f + 0.5f * std::sin(m_weather.dayNightCycle * 3.14159f);
         uint8_t bgR = static_cast<uint8_t>(10 + 40 * dayBrightness);
@@ -412,41 +419,51 @@ public:
         }
         
         renderer.clearScreen(Color(bgR, bgG, bgB));
+        m_renderCommands.clear();
+        
+        // the spatial grid is built before boids move, is born into or die, so culling tests current positions
+        ViewBounds view = renderer.getViewBounds();
+        ViewBounds boidView = view.expanded(CULL_MARGIN, CULL_PIXEL_MARGIN);
+        viewCullingSystem(kinematicsPool, boidView, getInterpolationAlpha(), m_renderPositions, m_visibleBoids);
         
         // Draw biome zones
         for (const auto& zone : m_zones) {
+            if (!view.overlapsCircle(zone.center, zone.radius)) continue;
+            
             Color zoneColor;
             if (zone.biomeType == 0) zoneColor = Color(40, 80, 40); // Forest
             else if (zone.biomeType == 1) zoneColor = Color(60, 90, 50); // Plains
             else zoneColor = Color(100, 80, 50); // Desert
             
-            renderer.drawCircle(zone.center, zone.radius, zoneColor);
+            m_renderCommands.addCircle(zone.center, zone.radius, zoneColor);
         }
         
         // Draw boundaries
         float border = 5.0f;
-        renderer.drawRectangle(Vector2(0, 0), Vector2(WORLD_WIDTH, border), Color(80, 80, 100));
-        renderer.drawRectangle(Vector2(0, WORLD_HEIGHT - border), Vector2(WORLD_WIDTH, WORLD_HEIGHT), Color(80, 80, 100));
-        renderer.drawRectangle(Vector2(0, 0), Vector2(border, WORLD_HEIGHT), Color(80, 80, 100));
-        renderer.drawRectangle(Vector2(WORLD_WIDTH - border, 0), Vector2(WORLD_WIDTH, WORLD_HEIGHT), Color(80, 80, 100));
+        m_renderCommands.addRectangle(Vector2(0, 0), Vector2(WORLD_WIDTH, border), Color(80, 80, 100));
+        m_renderCommands.addRectangle(Vector2(0, WORLD_HEIGHT - border), Vector2(WORLD_WIDTH, WORLD_HEIGHT), Color(80, 80, 100));
+        m_renderCommands.addRectangle(Vector2(0, 0), Vector2(border, WORLD_HEIGHT), Color(80, 80, 100));
+        m_renderCommands.addRectangle(Vector2(WORLD_WIDTH - border, 0), Vector2(WORLD_WIDTH, WORLD_HEIGHT), Color(80, 80, 100));
         
         // Draw obstacles
         for (const auto& obs : m_obstacles) {
+            if (!view.overlapsCircle(obs.position, obs.radius * 1.2f)) continue;
+            
             Color obsColor = obs.isNest ? Color(150, 120, 180) : obs.color;
-            renderer.drawCircle(obs.position, obs.radius, obsColor);
+            m_renderCommands.addCircle(obs.position, obs.radius, obsColor);
             if (obs.isNest) {
-                renderer.drawCircle(obs.position, obs.radius * 1.2f, Color(180, 150, 200));
+                m_renderCommands.addCircle(obs.position, obs.radius * 1.2f, Color(180, 150, 200));
             }
         }
         
         // Draw food
         for (const auto& food : m_food) {
-            if (food.consumed) continue;
-            renderer.drawCircle(food.position, food.radius, food.color);
+            if (food.consumed || !view.overlapsCircle(food.position, food.radius * 1.5f)) continue;
+            m_renderCommands.addCircle(food.position, food.radius, food.color);
             
             // Visual distinction for meat vs plants
             if (food.foodType == 1) {
-                renderer.drawCircle(food.position, food.radius * 1.5f, Color(140, 60, 60));
+                m_renderCommands.addCircle(food.position, food.radius * 1.5f, Color(140, 60, 60));
             }
         }
         
@@ -454,61 +471,81 @@ public:
         if (m_weather.windStrength > 5.0f) {
             Vector2 windStart(50, 50);
             Vector2 windEnd = windStart + m_weather.windDirection * (m_weather.windStrength * 2.0f);
-            renderer.drawLine(windStart, windEnd, Color(200, 200, 255));
+            m_renderCommands.addLine(windStart, windEnd, Color(200, 200, 255));
         }
         
         // Draw boids
-        for (const auto& boid : m_boids) {
-            if (boid.isDead) continue;
+        for (int i : m_visibleBoids) {
+            Entity e = kinematicsPool.entities[i];
+            const auto& style = renderStylePool.get(e);
+            const auto& lifecycle = lifecyclePool.get(e);
             
             // Energy-based transparency
-            float energyFactor = std::max(0.3f, boid.energy / 100.0f);
+            float energyFactor = std::max(0.3f, energyPool.get(e).energy / 100.0f);
             Color renderColor(
-                static_cast<uint8_t>(boid.color.r * energyFactor),
-                static_cast<uint8_t>(boid.color.g * energyFactor),
-                static_cast<uint8_t>(boid.color.b * energyFactor)
+                static_cast<uint8_t>(style.color.r * energyFactor),
+                static_cast<uint8_t>(style.color.g * energyFactor),
+                static_cast<uint8_t>(style.color.b * energyFactor)
             );
             
-            // Size based on type and age
-            float radius = boid.isChild ? 3.0f : 6.0f;
-            if (boid.type == 1) radius += 2.0f; // Carnivores larger
+            // Size based on type and age, children are 3 units smaller
+            float radius = lifecycle.isChild ? style.radius - 3.0f : style.radius;
             
-            renderer.drawCircle(boid.position, radius, renderColor);
+            m_renderCommands.addCircle(m_renderPositions[i], radius, renderColor);
+        }
+        
+        // Direction indicators and health bars go in a pass of their own so they are submitted as one batch
+        for (int i : m_visibleBoids) {
+            Entity e = kinematicsPool.entities[i];
+            const auto& kinematics = kinematicsPool.data[i];
+            const auto& style = renderStylePool.get(e);
+            const auto& lifecycle = lifecyclePool.get(e);
+            float radius = lifecycle.isChild ? style.radius - 3.0f : style.radius;
             
             // Draw velocity direction
-            if (boid.velocity.magnitude() > 0.1f) {
-                Vector2 dir = VectorMath::normalize(boid.velocity);
-                Vector2 endPoint = boid.position + dir * (radius + 6.0f);
-                renderer.drawLine(boid.position, endPoint, Color(255, 255, 255));
+            if (kinematics.velocity.magnitude() > 0.1f) {
+                Vector2 dir = VectorMath::normalize(kinematics.velocity);
+                Vector2 endPoint = m_renderPositions[i] + dir * (radius + 6.0f);
+                m_renderCommands.addLine(m_renderPositions[i], endPoint, Color(255, 255, 255));
             }
             
             // Health bar for low health boids
-            if (boid.health < 50.0f) {
-                Vector2 barStart = boid.position + Vector2(-8, -12);
-                Vector2 barEnd = barStart + Vector2(16.0f * (boid.health / 100.0f), 0);
-                renderer.drawLine(barStart, barEnd, Color(255, 0, 0));
+            if (lifecycle.health < 50.0f) {
+                Vector2 barStart = m_renderPositions[i] + Vector2(-8, -12);
+                Vector2 barEnd = barStart + Vector2(16.0f * (lifecycle.health / 100.0f), 0);
+                m_renderCommands.addLine(barStart, barEnd, Color(255, 0, 0));
             }
         }
         
         // Draw connections between flockmates
+        // (grid indices are from this frame's snapshot, taken before deaths and births moved
+        // boids around the pool, so they are mapped back to pool indices through the entity)
         int connectionCount = 0;
-        for (size_t i = 0; i < m_boids.size() && connectionCount < 200; i += 4) {
-            if (m_boids[i].isDead) continue;
+        FrameVector<int> nearby;
+        for (size_t i = 0; i < kinematicsPool.getSize() && connectionCount < 200; i += 4) {
+            const Vector2& position = m_renderPositions[i];
+            if (!boidView.contains(position)) continue;
             
-            auto nearby = m_spatialGrid.query(m_boids[i].position, 60.0f);
+            int type = speciesPool.get(kinematicsPool.entities[i]).type;
+            
+            m_spatialGrid.query(kinematicsPool.data[i].position, 60.0f, nearby);
             for (int idx : nearby) {
-                if (idx <= static_cast<int>(i) || m_boids[idx].isDead) continue;
-                if (m_boids[i].type != m_boids[idx].type) continue;
+                if (m_snapshot.species[idx] != type) continue;
+                
+                Entity mate = m_snapshot.entities[idx];
+                if (!kinematicsPool.has(mate)) continue;
+                std::size_t j = kinematicsPool.indexOf(mate);
+                if (j <= i) continue;
                 
-                float distSq = VectorMath::distanceSquared(m_boids[i].position, m_boids[idx].position);
+                float distSq = VectorMath::distanceSquared(position, m_renderPositions[j]);
                 if (distSq < 3600.0f) {
                     Color lineColor;
-                    if (m_boids[i].type == 0) lineColor = Color(100, 150, 255);
-                    else if (m_boids[i].type == 1) lineColor = Color(255, 100, 100);
-                    else if (m_boids[i].type == 2) lineColor = Color(200, 200, 100);
+                    if (type == 0) lineColor = Color(100, 150, 255);
+                    else if (type == 1) lineColor = Color(255, 100, 100);
+                    else if (type == 2) lineColor = Color(200, 200, 100);
                     else lineColor = Color(150, 100, 200);
                     
-                    renderer.drawLine(m_boids[i].position, m_boids[idx].position, lineColor);
+                    m_renderCommands.addLine(position, m_renderPositions[j], lineColor);
                     connectionCount++;
                     if (connectionCount >= 200) break;
                 }
@@ -517,58 +554,51 @@ public:
         
         // Rain effect
         if (m_weather.isRaining) {
-            std::uniform_real_distribution<float> xDist(0, WORLD_WIDTH);
-            std::uniform_real_distribution<float> yDist(0, WORLD_HEIGHT);
+            // separate stream so drawing never shifts the simulation's random sequence
+            RandomStream rng = m_random.entityStream(RandomSource::Purpose::Effects, 0, m_frameCounter);
             for (int i = 0; i < 50; ++i) {
-                Vector2 rainStart(xDist(m_rng), yDist(m_rng));
+                Vector2 rainStart(rng.uniform(0, WORLD_WIDTH), rng.uniform(0, WORLD_HEIGHT));
                 Vector2 rainEnd = rainStart + Vector2(5, 15);
-                renderer.drawLine(rainStart, rainEnd, Color(150, 150, 200));
+                if (!view.overlapsLine(rainStart, rainEnd)) continue;
+                m_renderCommands.addLine(rainStart, rainEnd, Color(150, 150, 200));
             }
         }
+        
+        renderer.submit(m_renderCommands);
     }
 
 private:
     void createZones() {
         // Create diverse biomes
-        std::uniform_real_distribution<float> xDist(200.0f, WORLD_WIDTH - 200.0f);
-        std::uniform_real_distribution<float> yDist(200.0f, WORLD_HEIGHT - 200.0f);
-        
         for (int i = 0; i < 6; ++i) {
             Zone zone;
-            zone.center = Vector2(xDist(m_rng), yDist(m_rng));
+            zone.center = Vector2(m_rng.uniform(200.0f, WORLD_WIDTH - 200.0f), m_rng.uniform(200.0f, WORLD_HEIGHT - 200.0f));
             zone.radius = 150.0f + (i * 20.0f);
             zone.biomeType = i % 3;
             m_zones.push_back(zone);
         }
     }
-    
+
     void createObstacles() {
-        std::uniform_real_distribution<float> xDist(150.0f, WORLD_WIDTH - 150.0f);
-        std::uniform_real_distribution<float> yDist(150.0f, WORLD_HEIGHT - 150.0f);
-        
         // Regular obstacles
         for (int i = 0; i < 10; ++i) {
-            Vector2 pos(xDist(m_rng), yDist(m_rng));
+            Vector2 pos(m_rng.uniform(150.0f, WORLD_WIDTH - 150.0f), m_rng.uniform(150.0f, WORLD_HEIGHT - 150.0f));
             float radius = 30.0f + (i * 3.0f);
             m_obstacles.emplace_back(pos, radius, Color(100, 100, 120), false);
         }
         
         // Nests (safe zones)
         for (int i = 0; i < 4; ++i) {
-            Vector2 pos(xDist(m_rng), yDist(m_rng));
+            Vector2 pos(m_rng.uniform(150.0f, WORLD_WIDTH - 150.0f), m_rng.uniform(150.0f, WORLD_HEIGHT - 150.0f));
             m_obstacles.emplace_back(pos, 40.0f, Color(150, 120, 180), true);
         }
     }
-    
+
     void spawnBoid(int type) {
-        if (m_boids.size() >= MAX_BOIDS) return;
-        
-        std::uniform_real_distribution<float> xDist(50.0f, WORLD_WIDTH - 50.0f);
-        std::uniform_real_distribution<float> yDist(50.0f, WORLD_HEIGHT - 50.0f);
-        std::uniform_real_distribution<float> velDist(-50.0f, 50.0f);
+        if (ecm.getPool<KinematicsComponent>().getSize() >= MAX_BOIDS) return;
         
-        Vector2 pos(xDist(m_rng), yDist(m_rng));
-        Vector2 vel(velDist(m_rng), velDist(m_rng));
+        Vector2 pos(m_rng.uniform(50.0f, WORLD_WIDTH - 50.0f), m_rng.uniform(50.0f, WORLD_HEIGHT - 50.0f));
+        Vector2 vel(m_rng.uniform(-50.0f, 50.0f), m_rng.uniform(-50.0f, 50.0f));
         
         Color color;
         if (type == 0) color = Color(100, 150, 255);      // Herbivore
@@ -576,37 +606,136 @@ private:
         else if (type == 2) color = Color(200, 200, 100); // Omnivore
         else color = Color(150, 100, 200);                 // Scavenger
         
-        m_boids.emplace_back(pos, vel, color, type, 0);
+        spawnChild(Birth{pos, vel, color, type, 0, GenesComponent{}});
     }
-    
+
+    void spawnChild(const Birth& birth) {
+        float radius = (birth.type == 1) ? 8.0f : 6.0f; // Carnivores larger
+        
+        auto boid = EntityWrapper{ecm.createEntity()};
+        boid.addComponent(KinematicsComponent{birth.position, birth.velocity});
+        boid.addComponent(SpeciesComponent{birth.type});
+        boid.addComponent(SteeringComponent{birth.genes.maxSpeed, 0.5f, birth.genes.perceptionRadius});
+        boid.addComponent(EnergyComponent{100.0f});
+        boid.addComponent(RenderStyleComponent{birth.color, radius});
+        boid.addComponent(GenesComponent{birth.genes});
+        boid.addComponent(LifecycleComponent{birth.generation});
+        boid.addComponent(SimulationLodComponent{});
+    }
+
     void spawnFood(int foodType) {
         if (m_food.size() >= MAX_FOOD) return;
         
-        std::uniform_real_distribution<float> xDist(30.0f, WORLD_WIDTH - 30.0f);
-        std::uniform_real_distribution<float> yDist(30.0f, WORLD_HEIGHT - 30.0f);
-        
-        m_food.emplace_back(Vector2(xDist(m_rng), yDist(m_rng)), foodType);
+        m_food.emplace_back(Vector2(m_rng.uniform(30.0f, WORLD_WIDTH - 30.0f), m_rng.uniform(30.0f, WORLD_HEIGHT - 30.0f)), foodType);
     }
-    
+
     void spawnFoodInZone(const Zone& zone, int foodType) {
         if (m_food.size() >= MAX_FOOD) return;
         
-        std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159f);
-        std::uniform_real_distribution<float> radiusDist(0.0f, zone.radius);
-        
-        float angle = angleDist(m_rng);
-        float radius = radiusDist(m_rng);
+        float angle = m_rng.uniform(0.0f, 2.0f * 3.14159f);
+        float radius = m_rng.uniform(0.0f, zone.radius);
         
         Vector2 pos = zone.center + Vector2(std::cos(angle), std::sin(angle)) * radius;
         m_food.emplace_back(pos, foodType);
     }
+
+    /**
+     * Computes every boid's steering force from m_snapshot and adds it to the boid's acceleration.
+     * Neighbour scans only read the snapshot; the boid's own genes are read once per boid.
+     * Boids are processed one species range at a time.
+     */
+    void steeringSystem(
+        ComponentPool<KinematicsComponent>& kinematicsPool,
+        const ComponentPool<SteeringComponent>& steeringPool,
+        float dt
+    ) {
+        PROFILE_ZONE("steeringSystem");
+
+        for (int species = 0; species < SPECIES_COUNT; ++species) {
+            SpeciesPartition::Range range = m_partition.getRange(species);
+            const Behaviour& behaviour = BEHAVIOURS[species];
+            
+            m_threadPool.parallelFor(range.getSize(), [&](size_t begin, size_t end) {
+                steerRange(kinematicsPool, steeringPool, behaviour, range.begin + begin, range.begin + end, dt);
+            }, BOIDS_PER_TASK);
+        }
+    }
+
+    /**
+     * Steers the boids at snapshot indices [begin, end), which all share one behaviour.
+     */
+    void steerRange(
+        ComponentPool<KinematicsComponent>& kinematicsPool,
+        const ComponentPool<SteeringComponent>& steeringPool,
+        const Behaviour& behaviour,
+        size_t begin,
+        size_t end,
+        float dt
+    ) {
+        PROFILE_ZONE("steerRange");
+
+        const auto& genesPool = ecm.getPool<GenesComponent>();
+        const auto& lodPool = ecm.getPool<SimulationLodComponent>();
+        
+        for (size_t i = begin; i < end; ++i) {
+            Entity e = m_snapshot.entities[i];
+            
+            // boids skipped by the LOD system keep their velocity, the ones that run
+            // apply their force over all the time accumulated since their last update
+            float forceScale = 1.0f;
+            if (SIMULATION_LOD) {
+                float stepTime = lodPool.get(e).stepTime;
+                if (stepTime <= 0.0f) continue;
+                forceScale = (dt > 0.0f) ? stepTime / dt : 1.0f;
+            }
+            
+            Vector2 force = updateBoidBehavior(i, steeringPool.get(e), genesPool.get(e), behaviour);
+            kinematicsPool.data[i].acceleration += force * forceScale;
+        }
+    }
+
+    /**
+     * Tiers count from the rectangle the renderer shows, so boids off screen slow down
+     * with their distance from it while the view is zoomed or panned in.
+     */
+    SimulationLodPolicy getLodPolicy() {
+        ViewBounds view = getRenderer().getViewBounds();
+        return SimulationLodPolicy{
+            view.max.y, view.min.y, view.min.x, view.max.x, LOD_TIER_DISTANCE, LOD_IDLE_TIER, LOD_MAX_TIER
+        };
+    }
     
-    void updateBoidBehavior(size_t index, float dt) {
-        auto& boid = m_boids[index];
+    Vector2 updateBoidBehavior(size_t index, const SteeringComponent& steering, const GenesComponent& genes,
+                               const Behaviour& behaviour) const {
+        const Vector2& position = m_snapshot.positions[index];
+        const Vector2& velocity = m_snapshot.velocities[index];
+        int type = m_snapshot.species[index];
+        Vector2 force(0, 0);
+        
+        // Get nearby boids using spatial grid. With approximate flocking the cell aggregates
+        // cover the perception radius, so the grid is only searched as far as separation,
+        // fleeing and hunting still look.
+        float searchRadius = steering.perceptionRadius * m_weather.getVisibilityModifier();
+        float queryRadius = searchRadius;
+        if (APPROXIMATE_FLOCKING) {
+            float exactRadius = SEPARATION_DISTANCE;
+            if (behaviour.flee != 0.0f) exactRadius = std::max(exactRadius, FLEE_RADIUS);
+            if (behaviour.hunt != 0.0f) exactRadius = std::max(exactRadius, HUNT_RADIUS);
+            queryRadius = std::min(searchRadius, exactRadius);
+        }
+        
+        // the scratch lists go back to the arena when this boid is done
+        FrameArena& arena = FrameArena::forThisThread();
+        FrameArena::Scope scratch(arena);
+        FrameVector<int> nearbyIndices{FrameAllocator<int>(arena)};
+        m_spatialGrid.query(position, queryRadius, nearbyIndices);
         
-        // Get nearby boids using spatial grid
-        float searchRadius = boid.genes.perceptionRadius * m_weather.getVisibilityModifier();
-        auto nearbyIndices = m_spatialGrid.query(boid.position, searchRadius);
+        // nearbyDistancesSquared[k] belongs to nearbyIndices[k]
+        FrameVector<float> nearbyDistancesSquared(nearbyIndices.size(), FrameAllocator<float>(arena));
+        VectorBatch::distanceSquared(
+            m_snapshot.positions.data(), nearbyIndices.data(), nearbyIndices.size(), position, nearbyDistancesSquared.data()
+        );
+        const float* distancesSquared = nearbyDistancesSquared.data();
         
         // Flocking forces (only with same type)
         Vector2 alignment(0, 0);
@@ -614,19 +743,29 @@ private:
         Vector2 separation(0, 0);
         int flockCount = 0;
         
-        for (int idx : nearbyIndices) {
-            if (idx == static_cast<int>(index) || m_boids[idx].isDead) continue;
-            if (m_boids[idx].type != boid.type) continue;
+        if (APPROXIMATE_FLOCKING) {
+            auto flock = m_cellAggregates.gatherNeighbours(position, velocity, searchRadius, type);
+            alignment = flock.velocitySum;
+            cohesion = flock.positionSum;
+            flockCount = flock.count;
+        }
+        
+        for (size_t k = 0; k < nearbyIndices.size(); ++k) {
+            int idx = nearbyIndices[k];
+            if (idx == static_cast<int>(index)) continue;
+            if (m_snapshot.species[idx] != type) continue;
             
-            float dist = VectorMath::distance(boid.position, m_boids[idx].position);
-            if (dist < searchRadius) {
-                alignment += m_boids[idx].velocity;
-                cohesion += m_boids[idx].position;
+            float distSquared = distancesSquared[k];
+            if (!APPROXIMATE_FLOCKING && distSquared < searchRadius * searchRadius) {
+                alignment += m_snapshot.velocities[idx];
+                cohesion += m_snapshot.positions[idx];
                 flockCount++;
             }
             
-            if (dist < SEPARATION_DISTANCE) {
-                Vector2 diff = boid.position - m_boids[idx].position;
+            // separation is always exact, it only involves very close neighbours
+            if (distSquared < SEPARATION_DISTANCE * SEPARATION_DISTANCE) {
+                float dist = std::sqrt(distSquared);
+                Vector2 diff = position - m_snapshot.positions[idx];
                 if (dist > 0.0001f) diff /= dist;
                 separation += diff;
             }
@@ -634,201 +773,252 @@ private:
         
         if (flockCount > 0) {
             alignment /= static_cast<float>(flockCount);
-            alignment = VectorMath::normalize(alignment) * boid.genes.maxSpeed;
-            alignment -= boid.velocity;
-            limitForce(alignment, boid.maxForce);
+            alignment = VectorMath::normalize(alignment) * steering.maxSpeed;
+            alignment -= velocity;
+            alignment = VectorMath::limit(alignment, steering.maxForce);
             
             cohesion /= static_cast<float>(flockCount);
-            cohesion = seek(boid, cohesion);
+            cohesion = seek(index, steering, cohesion);
             
-            boid.applyForce(alignment * ALIGNMENT_WEIGHT);
-            boid.applyForce(cohesion * COHESION_WEIGHT);
+            force += alignment * ALIGNMENT_WEIGHT;
+            force += cohesion * COHESION_WEIGHT;
         }
         
         if (separation.magnitude() > 0.0001f) {
-            separation = VectorMath::normalize(separation) * boid.genes.maxSpeed;
-            separation -= boid.velocity;
-            limitForce(separation, boid.maxForce);
-            boid.applyForce(separation * SEPARATION_WEIGHT);
+            separation = VectorMath::normalize(separation) * steering.maxSpeed;
+            separation -= velocity;
+            separation = VectorMath::limit(separation, steering.maxForce);
+            force += separation * SEPARATION_WEIGHT;
         }
         
-        // Type-specific behaviors
-        if (boid.type == 0) { // Herbivore
-            Vector2 seekFood = findNearestFood(boid, 0);
-            Vector2 flee = fleeFromPredators(boid, nearbyIndices);
-            boid.applyForce(seekFood * 1.5f);
-            boid.applyForce(flee * (3.0f * boid.genes.fearResponse));
-            
-        } else if (boid.type == 1) { // Carnivore
-            Vector2 hunt = huntPrey(boid, nearbyIndices);
-            boid.applyForce(hunt * (2.0f * boid.genes.aggression));
-            
-        } else if (boid.type == 2) { // Omnivore
-            Vector2 seekFood = findNearestFood(boid, -1); // Any food
-            Vector2 flee = fleeFromPredators(boid, nearbyIndices);
-            boid.applyForce(seekFood * 1.2f);
-            boid.applyForce(flee * (2.0f * boid.genes.fearResponse));
-        } else if (boid.type == 3) { // Scavenger
-            Vector2 seekMeat = findNearestFood(boid, 1); // Only meat
-            boid.applyForce(seekMeat * 1.8f);
+        // Species-specific behaviors
+        if (behaviour.seekFood != 0.0f) {
+            Vector2 seekFood = findNearestFood(index, steering, behaviour.foodType);
+            force += seekFood * behaviour.seekFood;
+        }
+        
+        if (behaviour.flee != 0.0f) {
+            Vector2 flee = fleeFromPredators(index, steering, nearbyIndices, distancesSquared);
+            force += flee * (behaviour.flee * genes.fearResponse);
+        }
+        
+        if (behaviour.hunt != 0.0f) {
+            Vector2 hunt = huntPrey(index, steering, nearbyIndices, distancesSquared);
+            force += hunt * (behaviour.hunt * genes.aggression);
         }
         
         // Environmental forces
-        Vector2 avoidObs = avoidObstacles(boid);
-        boid.applyForce(avoidObs * 2.5f);
+        Vector2 avoidObs = avoidObstacles(index, steering);
+        force += avoidObs * 2.5f;
         
-        Vector2 boundary = calculateBoundaryForce(boid);
-        boid.applyForce(boundary * 2.0f);
+        Vector2 boundary = calculateBoundaryForce(index, steering);
+        force += boundary * 2.0f;
         
         // Weather effects
         if (m_weather.windStrength > 2.0f) {
             Vector2 windForce = m_weather.getWindForce() * 0.1f;
-            boid.applyForce(windForce);
+            force += windForce;
         }
+        
+        return force;
     }
 
-    Vector2 seek(const Boid& boid, const Vector2& target) {
-        Vector2 desired = target - boid.position;
-        desired = VectorMath::normalize(desired) * boid.genes.maxSpeed;
-        Vector2 steer = desired - boid.velocity;
-        limitForce(steer, boid.maxForce);
-        return steer;
-    }
-
-    void limitForce(Vector2& force, float maxForce) {
-        float mag = force.magnitude();
-        if (mag > maxForce) {
-            force = VectorMath::normalize(force) * maxForce;
-        }
+    Vector2 seek(size_t index, const SteeringComponent& steering, const Vector2& target) const {
+        Vector2 desired = target - m_snapshot.positions[index];
+        desired = VectorMath::normalize(desired) * steering.maxSpeed;
+        Vector2 steer = desired - m_snapshot.velocities[index];
+        return VectorMath::limit(steer, steering.maxForce);
     }
 
-    Vector2 findNearestFood(const Boid& boid, int foodTypeFilter) {
-        float closestDist = 1000000.0f;
-        Vector2 target = boid.position;
+    Vector2 findNearestFood(size_t index, const SteeringComponent& steering, int foodTypeFilter) const {
+        const Vector2& position = m_snapshot.positions[index];
+        float closestDistSquared = 250.0f * 250.0f;
+        Vector2 target = position;
         bool found = false;
         
         for (const auto& food : m_food) {
             if (food.consumed) continue;
             if (foodTypeFilter >= 0 && food.foodType != foodTypeFilter) continue;
             
-            float dist = VectorMath::distance(boid.position, food.position);
-            if (dist < closestDist && dist < 250.0f) {
-                closestDist = dist;
+            float distSquared = VectorMath::distanceSquared(position, food.position);
+            if (distSquared < closestDistSquared) {
+                closestDistSquared = distSquared;
                 target = food.position;
                 found = true;
             }
         }
         
-        return found ? seek(boid, target) : Vector2(0, 0);
+        return found ? seek(index, steering, target) : Vector2(0, 0);
     }
 
-    Vector2 fleeFromPredators(const Boid& boid, const std::vector<int>& nearbyIndices) {
-        Vector2 steering(0, 0);
+    /**
+     * @param distancesSquared squared distance to each of nearbyIndices, in the same order
+     */
+    Vector2 fleeFromPredators(size_t index, const SteeringComponent& steering,
+                              const FrameVector<int>& nearbyIndices, const float* distancesSquared) const {
+        const Vector2& position = m_snapshot.positions[index];
+        Vector2 steer(0, 0);
         int count = 0;
         
-        for (int idx : nearbyIndices) {
-            if (m_boids[idx].isDead || m_boids[idx].type != 1) continue;
+        for (size_t k = 0; k < nearbyIndices.size(); ++k) {
+            int idx = nearbyIndices[k];
+            if (m_snapshot.species[idx] != 1) continue;
             
-            float dist = VectorMath::distance(boid.position, m_boids[idx].position);
-            if (dist < 150.0f) {
-                Vector2 diff = boid.position - m_boids[idx].position;
-                if (dist > 0.0001f) diff /= (dist * dist);
-                steering += diff;
+            float distSquared = distancesSquared[k];
+            if (distSquared < FLEE_RADIUS * FLEE_RADIUS) {
+                Vector2 diff = position - m_snapshot.positions[idx];
+                if (distSquared > 0.0001f * 0.0001f) diff /= distSquared;
+                steer += diff;
                 count++;
             }
         }
         
         if (count > 0) {
-            steering /= static_cast<float>(count);
-            steering = VectorMath::normalize(steering) * boid.genes.maxSpeed;
-            steering -= boid.velocity;
-            limitForce(steering, boid.maxForce * 2.0f);
+            steer /= static_cast<float>(count);
+            steer = VectorMath::normalize(steer) * steering.maxSpeed;
+            steer -= m_snapshot.velocities[index];
+            steer = VectorMath::limit(steer, steering.maxForce * 2.0f);
         }
         
-        return steering;
+        return steer;
     }
 
-    Vector2 huntPrey(const Boid& boid, const std::vector<int>& nearbyIndices) {
-        float closestDist = 1000000.0f;
-        Vector2 target = boid.position;
+    Vector2 huntPrey(size_t index, const SteeringComponent& steering,
+                     const FrameVector<int>& nearbyIndices, const float* distancesSquared) const {
+        const Vector2& position = m_snapshot.positions[index];
+        float closestDistSquared = HUNT_RADIUS * HUNT_RADIUS;
+        Vector2 target = position;
         bool found = false;
         
-        for (int idx : nearbyIndices) {
-            if (m_boids[idx].isDead || m_boids[idx].type == 1) continue;
+        for (size_t k = 0; k < nearbyIndices.size(); ++k) {
+            int idx = nearbyIndices[k];
+            if (m_snapshot.species[idx] == 1) continue;
             
-            float dist = VectorMath::distance(boid.position, m_boids[idx].position);
-            if (dist < closestDist && dist < 300.0f) {
-                closestDist = dist;
-                target = m_boids[idx].position;
+            if (distancesSquared[k] < closestDistSquared) {
+                closestDistSquared = distancesSquared[k];
+                target = m_snapshot.positions[idx];
                 found = true;
             }
         }
         
-        return found ? seek(boid, target) : Vector2(0, 0);
+        return found ? seek(index, steering, target) : Vector2(0, 0);
     }
 
-    Vector2 avoidObstacles(const Boid& boid) {
-        Vector2 steering(0, 0);
+    Vector2 avoidObstacles(size_t index, const SteeringComponent& steering) const {
+        const Vector2& position = m_snapshot.positions[index];
+        Vector2 steer(0, 0);
         
         for (const auto& obs : m_obstacles) {
-            float dist = VectorMath::distance(boid.position, obs.position);
+            float distSquared = VectorMath::distanceSquared(position, obs.position);
             float avoidRadius = obs.radius + 30.0f;
             
-            if (dist < avoidRadius) {
-                Vector2 diff = boid.position - obs.position;
-                if (dist > 0.0001f) diff /= (dist * dist);
-                steering += diff;
+            if (distSquared < avoidRadius * avoidRadius) {
+                Vector2 diff = position - obs.position;
+                if (distSquared > 0.0001f * 0.0001f) diff /= distSquared;
+                steer += diff;
             }
         }
         
-        if (steering.magnitude() > 0.0001f) {
-            steering = VectorMath::normalize(steering) * boid.genes.maxSpeed;
-            steering -= boid.velocity;
-            limitForce(steering, boid.maxForce * 2.0f);
+        if (steer.magnitude() > 0.0001f) {
+            steer = VectorMath::normalize(steer) * steering.maxSpeed;
+            steer -= m_snapshot.velocities[index];
+            steer = VectorMath::limit(steer, steering.maxForce * 2.0f);
         }
         
-        return steering;
+        return steer;
     }
 
-    Vector2 calculateBoundaryForce(const Boid& boid) {
-        Vector2 steering(0, 0);
+    Vector2 calculateBoundaryForce(size_t index, const SteeringComponent& steering) const {
+        const Vector2& position = m_snapshot.positions[index];
+        Vector2 steer(0, 0);
         const float margin = 50.0f;
         
-        if (boid.position.x < margin) steering.x = boid.genes.maxSpeed;
-        else if (boid.position.x > WORLD_WIDTH - margin) steering.x = -boid.genes.maxSpeed;
+        if (position.x < margin) steer.x = steering.maxSpeed;
+        else if (position.x > WORLD_WIDTH - margin) steer.x = -steering.maxSpeed;
         
-        if (boid.position.y < margin) steering.y = boid.genes.maxSpeed;
-        else if (boid.position.y > WORLD_HEIGHT - margin) steering.y = -boid.genes.maxSpeed;
+        if (position.y < margin) steer.y = steering.maxSpeed;
+        else if (position.y > WORLD_HEIGHT - margin) steer.y = -steering.maxSpeed;
         
-        return steering;
+        return steer;
     }
 
-    void wrapBoid(Boid& boid) {
-        if (boid.position.x < 0) boid.position.x = WORLD_WIDTH;
-        if (boid.position.x > WORLD_WIDTH) boid.position.x = 0;
-        if (boid.position.y < 0) boid.position.y = WORLD_HEIGHT;
-        if (boid.position.y > WORLD_HEIGHT) boid.position.y = 0;
+    /**
+     * Energy use, aging, reproduction cooldown and health. Runs over the cold pools only,
+     * apart from reading each boid's speed once.
+     */
+    void lifecycleSystem(float dt) {
+        PROFILE_ZONE("lifecycleSystem");
+
+        auto& lifecyclePool = ecm.getPool<LifecycleComponent>();
+        auto& energyPool = ecm.getPool<EnergyComponent>();
+        auto& genesPool = ecm.getPool<GenesComponent>();
+        auto& kinematicsPool = ecm.getPool<KinematicsComponent>();
+        
+        for (size_t i = 0; i < lifecyclePool.getSize(); ++i) {
+            Entity e = lifecyclePool.entities[i];
+            auto& lifecycle = lifecyclePool.data[i];
+            auto& energy = energyPool.get(e);
+            const auto& genes = genesPool.get(e);
+            
+            // Energy consumption based on metabolism and speed
+            float speed = kinematicsPool.get(e).velocity.magnitude();
+            float movementCost = (speed / genes.maxSpeed) * genes.metabolism;
+            energy.energy -= dt * (1.0f + movementCost);
+            
+            // Age the boid
+            lifecycle.age++;
+            if (lifecycle.age > 1800) { // 30 seconds at 60fps
+                lifecycle.isChild = false;
+            }
+            
+            // Reproduction cooldown
+            if (lifecycle.reproductionCooldown > 0.0f) {
+                lifecycle.reproductionCooldown -= dt;
+            }
+            
+            // Health deterioration when energy is low
+            if (energy.energy <= 0.0f) {
+                lifecycle.health -= dt * 10.0f;
+                if (lifecycle.health <= 0.0f) {
+                    lifecycle.isDead = true;
+                }
+            } else if (energy.energy > 50.0f && lifecycle.health < 100.0f) {
+                lifecycle.health += dt * 5.0f; // Regenerate health
+            }
+        }
     }
 
     void handleFoodConsumption() {
-        for (auto& boid : m_boids) {
-            if (boid.isDead) continue;
+        PROFILE_ZONE("handleFoodConsumption");
+
+        auto& kinematicsPool = ecm.getPool<KinematicsComponent>();
+        auto& speciesPool = ecm.getPool<SpeciesComponent>();
+        auto& energyPool = ecm.getPool<EnergyComponent>();
+        auto& lifecyclePool = ecm.getPool<LifecycleComponent>();
+        auto& lodPool = ecm.getPool<SimulationLodComponent>();
+        
+        for (size_t i = 0; i < kinematicsPool.getSize(); ++i) {
+            Entity e = kinematicsPool.entities[i];
+            const Vector2& position = kinematicsPool.data[i].position;
+            int type = speciesPool.get(e).type;
             
             for (auto& food : m_food) {
                 if (food.consumed) continue;
                 
                 // Check if boid can eat this food
                 bool canEat = false;
-                if (boid.type == 0 && food.foodType == 0) canEat = true; // Herbivore eats plants
-                else if (boid.type == 1 && food.foodType == 1) canEat = true; // Carnivore eats meat
-                else if (boid.type == 2) canEat = true; // Omnivore eats anything
-                else if (boid.type == 3 && food.foodType == 1) canEat = true; // Scavenger eats meat
+                if (type == 0 && food.foodType == 0) canEat = true; // Herbivore eats plants
+                else if (type == 1 && food.foodType == 1) canEat = true; // Carnivore eats meat
+                else if (type == 2) canEat = true; // Omnivore eats anything
+                else if (type == 3 && food.foodType == 1) canEat = true; // Scavenger eats meat
                 
                 if (canEat) {
-                    float dist = VectorMath::distance(boid.position, food.position);
-                    if (dist < 10.0f) {
+                    float distSquared = VectorMath::distanceSquared(position, food.position);
+                    if (distSquared < 10.0f * 10.0f && !lifecyclePool.get(e).isDead) {
                         food.consumed = true;
-                        boid.energy = std::min(100.0f, boid.energy + food.energy);
+                        auto& energy = energyPool.get(e);
+                        energy.energy = std::min(100.0f, energy.energy + food.energy);
+                        lodPool.get(e).markActive(LOD_ACTIVE_TIME);
                     }
                 }
             }
@@ -836,36 +1026,79 @@ private:
     }
 
     void handlePredation() {
-        for (auto& predator : m_boids) {
-            if (predator.isDead || predator.type != 1) continue;
+        PROFILE_ZONE("handlePredation");
+
+        auto& kinematicsPool = ecm.getPool<KinematicsComponent>();
+        auto& speciesPool = ecm.getPool<SpeciesComponent>();
+        auto& energyPool = ecm.getPool<EnergyComponent>();
+        auto& lifecyclePool = ecm.getPool<LifecycleComponent>();
+        auto& lodPool = ecm.getPool<SimulationLodComponent>();
+        
+        SpeciesPartition::Range carnivores = m_partition.getRange(1);
+        for (size_t i = carnivores.begin; i < carnivores.end; ++i) {
+            Entity predator = kinematicsPool.entities[i];
+            if (lifecyclePool.get(predator).isDead) continue;
             
-            for (auto& prey : m_boids) {
-                if (prey.isDead || prey.type == 1) continue;
+            for (size_t j = 0; j < kinematicsPool.getSize(); ++j) {
+                Entity prey = kinematicsPool.entities[j];
+                if (speciesPool.get(prey).type == 1) continue;
                 
-                float dist = VectorMath::distance(predator.position, prey.position);
-                if (dist < 12.0f) {
-                    prey.isDead = true;
-                    predator.energy = std::min(100.0f, predator.energy + 60.0f);
+                float distSquared = VectorMath::distanceSquared(kinematicsPool.data[i].position, kinematicsPool.data[j].position);
+                if (distSquared < LOD_ALERT_RADIUS * LOD_ALERT_RADIUS) {
+                    // a chase is on, keep both boids at full update rate
+                    lodPool.get(predator).markActive(LOD_ACTIVE_TIME);
+                    lodPool.get(prey).markActive(LOD_ACTIVE_TIME);
+                }
+                
+                if (distSquared < 12.0f * 12.0f) {
+                    auto& preyLifecycle = lifecyclePool.get(prey);
+                    if (preyLifecycle.isDead) continue;
+                    
+                    preyLifecycle.isDead = true;
+                    auto& predatorEnergy = energyPool.get(predator);
+                    predatorEnergy.energy = std::min(100.0f, predatorEnergy.energy + 60.0f);
                 }
             }
         }
     }
 
+    /**
+     * Walks the cold lifecycle pool for candidates and only touches kinematics for boids
+     * that could reproduce. Children are queued in m_births and spawned after deletion.
+     */
     void handleReproduction() {
-        if (m_boids.size() >= MAX_BOIDS - 10) return;
-        
-        for (size_t i = 0; i < m_boids.size(); ++i) {
-            auto& boid = m_boids[i];
-            if (boid.isDead || boid.isChild) continue;
-            if (boid.energy < boid.genes.reproductionThreshold) continue;
-            if (boid.reproductionCooldown > 0.0f) continue;
+        PROFILE_ZONE("handleReproduction");
+
+        auto& lifecyclePool = ecm.getPool<LifecycleComponent>();
+        auto& genesPool = ecm.getPool<GenesComponent>();
+        auto& energyPool = ecm.getPool<EnergyComponent>();
+        auto& kinematicsPool = ecm.getPool<KinematicsComponent>();
+        auto& renderStylePool = ecm.getPool<RenderStyleComponent>();
+        auto& speciesPool = ecm.getPool<SpeciesComponent>();
+        auto& lodPool = ecm.getPool<SimulationLodComponent>();
+        
+        if (kinematicsPool.getSize() >= MAX_BOIDS - 10) return;
+        
+        FrameVector<int> nearby;
+        
+        for (size_t i = 0; i < lifecyclePool.getSize(); ++i) {
+            Entity e = lifecyclePool.entities[i];
+            auto& lifecycle = lifecyclePool.data[i];
+            if (lifecycle.isDead || lifecycle.isChild) continue;
+            if (lifecycle.reproductionCooldown > 0.0f) continue;
+            
+            const auto& genes = genesPool.get(e);
+            auto& energy = energyPool.get(e);
+            if (energy.energy < genes.reproductionThreshold) continue;
+            
+            const Vector2& position = kinematicsPool.get(e).position;
             
             // Check if near a nest
             bool nearNest = false;
             for (const auto& obs : m_obstacles) {
                 if (obs.isNest) {
-                    float dist = VectorMath::distance(boid.position, obs.position);
-                    if (dist < obs.radius + 20.0f) {
+                    float nestRadius = obs.radius + 20.0f;
+                    if (VectorMath::distanceSquared(position, obs.position) < nestRadius * nestRadius) {
                         nearNest = true;
                         break;
                     }
@@ -874,31 +1107,41 @@ private:
             
             if (!nearNest) continue;
             
+            int type = speciesPool.get(e).type;
+            
             // Find a mate
-            auto nearby = m_spatialGrid.query(boid.position, 50.0f);
+            m_spatialGrid.query(position, 50.0f, nearby);
             for (int idx : nearby) {
-                if (idx == static_cast<int>(i)) continue;
-                if (m_boids[idx].isDead || m_boids[idx].isChild) continue;
-                if (m_boids[idx].type != boid.type) continue;
-                if (m_boids[idx].energy < m_boids[idx].genes.reproductionThreshold) continue;
+                Entity mate = m_snapshot.entities[idx];
+                if (mate == e) continue;
+                if (m_snapshot.species[idx] != type) continue;
+                
+                auto& mateLifecycle = lifecyclePool.get(mate);
+                if (mateLifecycle.isDead || mateLifecycle.isChild) continue;
+                
+                auto& mateEnergy = energyPool.get(mate);
+                if (mateEnergy.energy < genesPool.get(mate).reproductionThreshold) continue;
                 
                 // Reproduce!
-                Vector2 childPos = (boid.position + m_boids[idx].position) * 0.5f;
-                std::uniform_real_distribution<float> velDist(-30.0f, 30.0f);
-                Vector2 childVel(velDist(m_rng), velDist(m_rng));
+                Vector2 childPos = (position + kinematicsPool.get(mate).position) * 0.5f;
+                // keyed by parent and frame, a boid reproduces at most once per frame
+                RandomStream rng = m_random.entityStream(RandomSource::Purpose::Birth, e.getId(), m_frameCounter);
+                Vector2 childVel(rng.uniform(-30.0f, 30.0f), rng.uniform(-30.0f, 30.0f));
                 
-                int newGen = std::max(boid.generation, m_boids[idx].generation) + 1;
+                int newGen = std::max(lifecycle.generation, mateLifecycle.generation) + 1;
                 m_generationMax = std::max(m_generationMax, newGen);
                 
-                Boid child(childPos, childVel, boid.color, boid.type, newGen);
-                child.genes = boid.genes.mutate(m_rng);
-                m_boids.push_back(child);
+                m_births.push_back(Birth{
+                    childPos, childVel, renderStylePool.get(e).color, type, newGen, genes.mutate(rng)
+                });
                 
                 // Cost of reproduction
-                boid.energy -= 40.0f;
-                m_boids[idx].energy -= 40.0f;
-                boid.reproductionCooldown = 5.0f;
-                m_boids[idx].reproductionCooldown = 5.0f;
+                energy.energy -= 40.0f;
+                mateEnergy.energy -= 40.0f;
+                lifecycle.reproductionCooldown = 5.0f;
+                mateLifecycle.reproductionCooldown = 5.0f;
+                lodPool.get(e).markActive(LOD_ACTIVE_TIME);
+                lodPool.get(mate).markActive(LOD_ACTIVE_TIME);
                 
                 m_totalBirths++;
                 break;
@@ -906,24 +1149,51 @@ private:
         }
     }
 
+    /**
+     * Leaves a corpse for every dead adult and queues all dead boids for deletion.
+     */
+    void removeDeadBoids() {
+        PROFILE_ZONE("removeDeadBoids");
+
+        auto& lifecyclePool = ecm.getPool<LifecycleComponent>();
+        auto& kinematicsPool = ecm.getPool<KinematicsComponent>();
+        
+        for (size_t i = 0; i < lifecyclePool.getSize(); ++i) {
+            const auto& lifecycle = lifecyclePool.data[i];
+            if (!lifecycle.isDead) continue;
+            
+            Entity e = lifecyclePool.entities[i];
+            if (!lifecycle.isChild && m_food.size() < MAX_FOOD) {
+                m_food.emplace_back(kinematicsPool.get(e).position, 1); // Meat
+            }
+            
+            ecm.entityRemover.add(e);
+            m_totalDeaths++;
+        }
+    }
+
     void printStats() {
         int herbivores = 0, carnivores = 0, omnivores = 0, scavengers = 0;
         float avgGeneration = 0.0f;
         
-        for (const auto& boid : m_boids) {
-            if (boid.type == 0) herbivores++;
-            else if (boid.type == 1) carnivores++;
-            else if (boid.type == 2) omnivores++;
+        for (const auto& species : ecm.getPool<SpeciesComponent>().data) {
+            if (species.type == 0) herbivores++;
+            else if (species.type == 1) carnivores++;
+            else if (species.type == 2) omnivores++;
             else scavengers++;
-            avgGeneration += boid.generation;
         }
         
-        if (!m_boids.empty()) {
-            avgGeneration /= m_boids.size();
+        auto& lifecyclePool = ecm.getPool<LifecycleComponent>();
+        for (const auto& lifecycle : lifecyclePool.data) {
+            avgGeneration += lifecycle.generation;
+        }
+        
+        if (lifecyclePool.getSize() > 0) {
+            avgGeneration /= lifecyclePool.getSize();
         }
         
         std::cout << "[T=" << static_cast<int>(m_globalTime) << "s] "
-                << "H:" << herbivores << " C:" << carnivores 
+                << "H:" << herbivores << " C:" << carnivores
                 << " O:" << omnivores << " S:" << scavengers
                 << " | Births:" << m_totalBirths << " Deaths:" << m_totalDeaths
                 << " | AvgGen:" << avgGeneration << " MaxGen:" << m_generationMax
@@ -13,6 +13,7 @@ public:
     using Application::Application;
 
     EntityComponentManager& ecm = EntityComponentManager::getInstance(); 
+    TimerWheel lifetimeWheel;
 
     bool onStart() override {
         getRenderer().setCameraSpace(10.0f, -10.0f, -10.0f, 10.0f);
@@ -20,7 +21,7 @@ public:
         // static dot
         auto staticDot = EntityWrapper{ecm.createEntity()};
         staticDot.addComponent(PositionComponent{5.1f, 5.0f});
-        staticDot.addComponent(LifetimeComponent{10.0f});
+        addLifetime(lifetimeWheel, staticDot.getEntity(), 10.0f);
 
         // moving dot
         auto movingDot = EntityWrapper{ecm.createEntity()};
@@ -46,7 +47,7 @@ public:
         auto& velocityPool = ecm.getPool<VelocityComponent>();
 
         // run systems
-        lifetimeSystem(lifetimePool, ecm.entityRemover, dt);
+        lifetimeSystem(lifetimePool, lifetimeWheel, ecm.entityRemover, dt);
         movementSystem(positionPool, velocityPool, dt);
         
         // deferred deletion of entities
@@ -61,20 +62,29 @@ public:
         auto& positionPool = ecm.getPool<PositionComponent>();
         auto& velocityPool = ecm.getPool<VelocityComponent>();
 
+        // margin for the velocity lines and the dot radius in pixels
+        ViewBounds view = renderer.getViewBounds().expanded(2.0f, 5.0f);
+
+        // with a fixed timestep, step back to where the dots were at the frame's point between
+        // the last two ticks; velocities are constant, so that is exact
+        float rewind = (1.0f - getInterpolationAlpha()) * getFixedDeltaTime();
+
         for (std::size_t i = 0; i < positionPool.getSize(); ++i) {
             Entity e = positionPool.entities[i];
-            auto& position = positionPool.data[i];
+            Vector2 position{positionPool.data[i].x, positionPool.data[i].y};
+
+            Vector2 velocity{0.0f, 0.0f};
+            if (velocityPool.has(e)) {
+                velocity = Vector2{velocityPool.get(e).x, velocityPool.get(e).y};
+                position -= velocity * rewind;
+            }
+
+            if (!view.contains(position)) continue;
             
-            renderer.drawCircle(Vector2{position.x, position.y}, 5.0f, Color{0, 100, 250});            
+            renderer.drawCircle(position, 5.0f, Color{0, 100, 250});            
 
             if (velocityPool.has(e)) {
-                auto& velocity = velocityPool.get(e);
-                
-                renderer.drawLine(
-                    Vector2{position.x, position.y},
-                    Vector2{position.x + velocity.x, position.y + velocity.y},
-                    Color{255, 0, 0}
-                );
+                renderer.drawLine(position, position + velocity, Color{255, 0, 0});
             }
         }
     }
@@ -2,81 +2,43 @@
 
 #include "Application.hpp"
 #include "IRenderer.hpp"
+#include "RenderCommandList.hpp"
 #include "Vector2.hpp"
+#include "VectorMath.hpp"
+#include "Vector2x8.hpp"
+#include "Random.hpp"
+#include "ThreadPool.hpp"
+#include "Profiler.hpp"
+#include "FrameArena.hpp"
+
+#include "EntityComponentManager.hpp"
+#include "EntityWrapper.hpp"
+#include "KinematicsComponent.hpp"
+#include "SteeringComponent.hpp"
+#include "EnergyComponent.hpp"
+#include "SpeciesComponent.hpp"
+#include "RenderStyleComponent.hpp"
+#include "SimulationLodComponent.hpp"
+#include "FlockSnapshot.hpp"
+#include "FlockCellAggregates.hpp"
+#include "SpeciesPartition.hpp"
+#include "KinematicsSystem.hpp"
+#include "SimulationLodSystem.hpp"
+#include "EnergySystem.hpp"
+#include "ViewCullingSystem.hpp"
+
 #include <vector>
-#include <random>
 #include <cmath>
 #include <algorithm>
-
-// Helper functions for Vector2
-namespace VectorMath {
-    inline Vector2 normalize(const Vector2& v) {
-        float mag = v.magnitude();
-        return (mag > 0.0001f) ? v / mag : Vector2(0, 0);
-    }
-    
-    inline float dot(const Vector2& a, const Vector2& b) {
-        return a.x * b.x + a.y * b.y;
-    }
-    
-    inline float distanceSquared(const Vector2& a, const Vector2& b) {
-        Vector2 diff = b - a;
-        return diff.x * diff.x + diff.y * diff.y;
-    }
-    
-    inline float distance(const Vector2& a, const Vector2& b) {
-        return std::sqrt(distanceSquared(a, b));
-    }
-}
-
-struct Boid {
-    Vector2 position;
-    Vector2 velocity;
-    Vector2 acceleration;
-    Color color;
-    float maxSpeed;
-    float maxForce;
-    float perceptionRadius;
-    int type; // 0=prey, 1=predator, 2=neutral
-    float energy;
-    bool isDead;
-    
-    Boid(Vector2 pos, Vector2 vel, Color col, float speed, int t)
-        : position(pos), velocity(vel), acceleration(0, 0), color(col),
-          maxSpeed(speed), maxForce(0.5f), perceptionRadius(50.0f),
-          type(t), energy(100.0f), isDead(false) {}
-    
-    void applyForce(const Vector2& force) {
-        acceleration += force;
-    }
-    
-    void update(float dt) {
-        velocity += acceleration * dt;
-        
-        // Limit velocity
-        float speed = velocity.magnitude();
-        if (speed > maxSpeed) {
-            velocity = VectorMath::normalize(velocity) * maxSpeed;
-        }
-        
-        position += velocity * dt;
-        acceleration *= 0.0f; // Reset acceleration
-        
-        // Decrease energy
-        energy -= dt * 2.0f;
-        if (energy <= 0.0f) {
-            isDead = true;
-        }
-    }
-};
+#include <numeric>
 
 struct Food {
     Vector2 position;
     float radius;
     Color color;
     bool consumed;
-    
-    Food(Vector2 pos) : position(pos), radius(5.0f), 
+
+    Food(Vector2 pos) : position(pos), radius(5.0f),
                         color(100, 255, 100), consumed(false) {}
 };
 
@@ -84,34 +46,110 @@ struct Obstacle {
     Vector2 position;
     float radius;
     Color color;
-    
+
     Obstacle(Vector2 pos, float r, Color col)
         : position(pos), radius(r), color(col) {}
 };
 
+/**
+ * Boids are entities with the following components:
+ *  - KinematicsComponent: position, velocity and accumulated steering force (hot)
+ *  - SpeciesComponent: 0=prey, 1=predator, 2=neutral
+ *  - SteeringComponent: speed/force limits and perception radius (cold)
+ *  - EnergyComponent: drained over time, the boid dies when it runs out
+ *  - RenderStyleComponent: base color and radius
+ *  - SimulationLodComponent: update-rate tier
+ */
 class FlockSimulationApp : public Application {
 private:
-    std::vector<Boid> m_boids;
+    EntityComponentManager& ecm = EntityComponentManager::getInstance();
+    ThreadPool& m_threadPool = ThreadPool::getInstance();
+
+    // read side of the steering pass, forces are written to the kinematics pool
+    FlockSnapshot m_snapshot;
+    std::vector<int> m_snapshotIndices; // 0 .. n - 1, every boid's neighbour list without approximation
+    SpeciesPartition m_partition;
+    FlockCellAggregates m_cellAggregates;
+
     std::vector<Food> m_food;
     std::vector<Obstacle> m_obstacles;
-    std::mt19937 m_rng;
-    
+
+    // recorded in onRender and drawn in one submit, reused every frame
+    RenderCommandList m_renderCommands;
+    std::vector<Vector2> m_renderPositions; // scratch for viewCullingSystem
+    std::vector<int> m_visibleBoids;
+
+    // 0 picks a new seed every run, the seed in use is printed on start
+    const std::uint64_t RANDOM_SEED = 0;
+    RandomSource m_random;
+    RandomStream m_rng; // main thread only
+
     const float WORLD_WIDTH = 1400.0f;
     const float WORLD_HEIGHT = 900.0f;
     const size_t MAX_BOIDS = 500;
     const size_t MAX_FOOD = 200;
-    
+
     // Flocking parameters
     const float ALIGNMENT_WEIGHT = 1.0f;
     const float COHESION_WEIGHT = 1.0f;
     const float SEPARATION_WEIGHT = 1.5f;
     const float SEPARATION_DISTANCE = 25.0f;
+    const float FLEE_RADIUS = 150.0f;
+    const float HUNT_RADIUS = 300.0f;
+    
+    /**
+     * Steering weights of one species. A zero weight skips that behaviour. Boids are
+     * steered one species range at a time, so these checks are the same for a whole batch.
+     */
+    struct Behaviour {
+        float alignment;
+        float cohesion;
+        float separation;
+        float seekFood;
+        float obstacles;
+        float boundary;
+        int fleeFrom; // species to flee from, -1 for none
+        float flee;
+        int hunts;    // species to hunt, -1 for none
+        float hunt;
+    };
     
+    static constexpr int SPECIES_COUNT = 3;
+    
+    // indexed by species: prey, predator, neutral
+    const Behaviour BEHAVIOURS[SPECIES_COUNT] = {
+        {ALIGNMENT_WEIGHT, COHESION_WEIGHT, SEPARATION_WEIGHT, 1.5f, 2.0f, 2.0f, 1, 3.0f, -1, 0.0f},
+        {0.0f, 0.0f, SEPARATION_WEIGHT * 0.5f, 0.0f, 2.0f, 2.0f, -1, 0.0f, 0, 2.5f},
+        {ALIGNMENT_WEIGHT, COHESION_WEIGHT, SEPARATION_WEIGHT, 0.0f, 2.0f, 2.0f, -1, 0.0f, -1, 0.0f}
+    };
+    
+    // Approximate alignment and cohesion from per-cell sums instead of visiting every flockmate.
+    // Smaller cells follow the perception radius more closely at a higher per-boid cost.
+    const bool APPROXIMATE_FLOCKING = false;
+    const float AGGREGATE_CELL_SIZE = 25.0f;
+
+    // Time-sliced level of detail: idle boids, or boids far outside the camera, only run
+    // their behaviour every 2^tier frames and apply the accumulated time when they do.
+    const bool SIMULATION_LOD = false;
+    const float LOD_TIER_DISTANCE = 200.0f;
+    const int LOD_IDLE_TIER = 1;
+    const int LOD_MAX_TIER = 3;
+    const float LOD_ACTIVE_TIME = 1.0f; // seconds at full rate after an interaction
+    const float LOD_ALERT_RADIUS = 150.0f;
+    
+    const float ENERGY_DRAIN = 2.0f; // per second
+    const size_t BOIDS_PER_TASK = 16;
+
+    // Boids further than this outside the camera are not drawn. Covers the longest line
+    // drawn from a boid (camera units) and the largest boid radius (pixels).
+    const float CULL_MARGIN = 50.0f;
+    const float CULL_PIXEL_MARGIN = 10.0f;
+
     float m_globalTime = 0.0f;
     float m_foodSpawnTimer = 0.0f;
     float m_boidSpawnTimer = 0.0f;
     int m_frameCounter = 0;
-    
+
     // Stats
     int m_totalBoidsSpawned = 0;
     int m_preyEaten = 0;
@@ -119,21 +157,33 @@ private:
 
 public:
     explicit FlockSimulationApp(std::unique_ptr<ICore> core)
-        : Application(std::move(core)), m_rng(std::random_device{}()) {}
+        : Application(std::move(core)), m_random(RANDOM_SEED), m_rng(m_random.stream(RandomSource::Purpose::Main)) {}
 
     bool onStart() override {
         std::cout << "=== Flock Simulation with Predator-Prey Dynamics ===\n";
         std::cout << "Initializing ecosystem...\n";
+        std::cout << "Random seed: " << m_random.getSeed() << "\n";
         
         // Set camera: top, bottom, left, right
         getRenderer().setCameraSpace(WORLD_HEIGHT, 0, 0, WORLD_WIDTH);
         
-        m_boids.reserve(MAX_BOIDS);
         m_food.reserve(MAX_FOOD);
         
+        // every boid has these, so their pools are sized for the largest population once
+        ecm.reserveEntities(MAX_BOIDS);
+        ecm.reserveComponents<KinematicsComponent>(MAX_BOIDS);
+        ecm.reserveComponents<SpeciesComponent>(MAX_BOIDS);
+        ecm.reserveComponents<SteeringComponent>(MAX_BOIDS);
+        ecm.reserveComponents<EnergyComponent>(MAX_BOIDS);
+        ecm.reserveComponents<RenderStyleComponent>(MAX_BOIDS);
+        ecm.reserveComponents<SimulationLodComponent>(MAX_BOIDS);
+        
         // Create obstacles
         createObstacles();
         
+        m_cellAggregates.initialize(WORLD_WIDTH, WORLD_HEIGHT, AGGREGATE_CELL_SIZE, SPECIES_COUNT);
+        m_partition.initialize(SPECIES_COUNT);
+        
         // Spawn initial prey boids
         for (int i = 0; i < 50; ++i) {
             spawnBoid(0); // prey
@@ -154,15 +204,17 @@ public:
             spawnFood();
         }
         
-        std::cout << "Initial boids: " << m_boids.size() << "\n";
+        auto& kinematicsPool = ecm.getPool<KinematicsComponent>();
+        
+        std::cout << "Initial boids: " << kinematicsPool.getSize() << "\n";
         std::cout << "Initial food: " << m_food.size() << "\n";
         std::cout << "Obstacles: " << m_obstacles.size() << "\n";
         
         // Debug: Print first few boid positions
         std::cout << "Sample boid positions:\n";
-        for (size_t i = 0; i < std::min(size_t(5), m_boids.size()); ++i) {
-            std::cout << "  Boid " << i << ": (" << m_boids[i].position.x 
-                      << ", " << m_boids[i].position.y << ")\n";
+        for (size_t i = 0; i < std::min(size_t(5), kinematicsPool.getSize()); ++i) {
+            std::cout << "  Boid " << i << ": (" << kinematicsPool.data[i].position.x
+                      << ", " << kinematicsPool.data[i].position.y << ")\n";
         }
         
         std::cout << "Simulation started!\n";
@@ -175,18 +227,21 @@ public:
         std::cout << "Total boids spawned: " << m_totalBoidsSpawned << "\n";
         std::cout << "Prey eaten by predators: " << m_preyEaten << "\n";
         std::cout << "Food consumed: " << m_foodEaten << "\n";
-        std::cout << "Final boid count: " << m_boids.size() << "\n";
+        std::cout << "Final boid count: " << ecm.getPool<KinematicsComponent>().getSize() << "\n";
         std::cout << "Shutting down simulation...\n";
     }
 
     void onUpdate(float dt) override {
-        dt = std::min(dt, 0.1f); // Clamp dt
-        
         m_frameCounter++;
         m_globalTime += dt;
         m_foodSpawnTimer += dt;
         m_boidSpawnTimer += dt;
         
+        auto& kinematicsPool = ecm.getPool<KinematicsComponent>();
+        auto& steeringPool = ecm.getPool<SteeringComponent>();
+        auto& speciesPool = ecm.getPool<SpeciesComponent>();
+        auto& energyPool = ecm.getPool<EnergyComponent>();
+        
         // Spawn food periodically
         if (m_foodSpawnTimer > 0.5f && m_food.size() < MAX_FOOD) {
             for (int i = 0; i < 2; ++i) {
@@ -196,55 +251,28 @@ public:
         }
         
         // Spawn new boids occasionally
-        if (m_boidSpawnTimer > 3.0f && m_boids.size() < MAX_BOIDS) {
-            std::uniform_int_distribution<int> typeDist(0, 10);
-            int type = (typeDist(m_rng) < 8) ? 0 : 1; // 80% prey, 20% predator
+        if (m_boidSpawnTimer > 3.0f && kinematicsPool.getSize() < MAX_BOIDS) {
+            int type = (m_rng.uniformInt(0, 10) < 8) ? 0 : 1; // 80% prey, 20% predator
             spawnBoid(type);
             m_boidSpawnTimer = 0.0f;
         }
         
-        // Update all boids with flocking behavior
-        for (size_t i = 0; i < m_boids.size(); ++i) {
-            if (m_boids[i].isDead) continue;
-            
-            Vector2 alignment = calculateAlignment(i);
-            Vector2 cohesion = calculateCohesion(i);
-            Vector2 separation = calculateSeparation(i);
-            Vector2 avoidObstacles = calculateObstacleAvoidance(i);
-            
-            // Type-specific behaviors
-            if (m_boids[i].type == 0) { // Prey
-                Vector2 seekFood = calculateSeekFood(i);
-                Vector2 fleePredators = calculateFleePredators(i);
-                
-                m_boids[i].applyForce(alignment * ALIGNMENT_WEIGHT);
-                m_boids[i].applyForce(cohesion * COHESION_WEIGHT);
-                m_boids[i].applyForce(separation * SEPARATION_WEIGHT);
-                m_boids[i].applyForce(seekFood * 1.5f);
-                m_boids[i].applyForce(fleePredators * 3.0f);
-                m_boids[i].applyForce(avoidObstacles * 2.0f);
-                
-            } else if (m_boids[i].type == 1) { // Predator
-                Vector2 huntPrey = calculateHuntPrey(i);
-                
-                m_boids[i].applyForce(separation * SEPARATION_WEIGHT * 0.5f);
-                m_boids[i].applyForce(huntPrey * 2.5f);
-                m_boids[i].applyForce(avoidObstacles * 2.0f);
-                
-            } else { // Neutral
-                m_boids[i].applyForce(alignment * ALIGNMENT_WEIGHT);
-                m_boids[i].applyForce(cohesion * COHESION_WEIGHT);
-                m_boids[i].applyForce(separation * SEPARATION_WEIGHT);
-                m_boids[i].applyForce(avoidObstacles * 2.0f);
-            }
-            
-            // Apply boundary wrapping
-            Vector2 boundaryForce = calculateBoundaryForce(i);
-            m_boids[i].applyForce(boundaryForce * 2.0f);
-            
-            m_boids[i].update(dt);
-            wrapBoid(m_boids[i]);
+        // run systems
+        m_partition.update(kinematicsPool, speciesPool);
+        m_snapshot.capture(kinematicsPool, speciesPool);
+        if (APPROXIMATE_FLOCKING) {
+            m_cellAggregates.build(m_snapshot);
+        } else {
+            m_snapshotIndices.resize(m_snapshot.getSize());
+            std::iota(m_snapshotIndices.begin(), m_snapshotIndices.end(), 0);
+        }
+        if (SIMULATION_LOD) {
+            simulationLodSystem(ecm.getPool<SimulationLodComponent>(), kinematicsPool, getLodPolicy(), m_frameCounter, dt);
         }
+        steeringSystem(kinematicsPool, steeringPool, dt);
+        kinematicsSystem(kinematicsPool, steeringPool, dt);
+        worldWrapSystem(kinematicsPool, WORLD_WIDTH, WORLD_HEIGHT);
+        energySystem(energyPool, ecm.entityRemover, ENERGY_DRAIN, dt);
         
         // Handle food consumption
         handleFoodConsumption();
@@ -252,12 +280,8 @@ public:
         // Handle predator hunting
         handlePredatorHunting();
         
-        // Remove dead entities
-        m_boids.erase(
-            std::remove_if(m_boids.begin(), m_boids.end(),
-                [](const Boid& b) { return b.isDead; }),
-            m_boids.end()
-        );
+        // deferred deletion of entities
+        ecm.deleteEntities();
         
         m_food.erase(
             std::remove_if(m_food.begin(), m_food.end(),
@@ -268,14 +292,14 @@ public:
         // Periodic stats
         if (m_frameCounter % 180 == 0) {
             int preyCount = 0, predatorCount = 0, neutralCount = 0;
-            for (const auto& b : m_boids) {
-                if (b.type == 0) preyCount++;
-                else if (b.type == 1) predatorCount++;
+            for (const auto& species : speciesPool.data) {
+                if (species.type == 0) preyCount++;
+                else if (species.type == 1) predatorCount++;
                 else neutralCount++;
             }
             
             std::cout << "[T=" << static_cast<int>(m_globalTime) << "s] "
-                      << "Prey: " << preyCount 
+                      << "Prey: " << preyCount
                       << " | Predators: " << predatorCount
                       << " | Neutral: " << neutralCount
                       << " | Food: " << m_food.size() << "\n";
@@ -285,110 +309,291 @@ public:
     void onRender() override {
         IRenderer& renderer = getRenderer();
         
+        auto& kinematicsPool = ecm.getPool<KinematicsComponent>();
+        auto& speciesPool = ecm.getPool<SpeciesComponent>();
+        auto& energyPool = ecm.getPool<EnergyComponent>();
+        auto& renderStylePool = ecm.getPool<RenderStyleComponent>();
+        
         // Gradient background
         uint8_t bgR = static_cast<uint8_t>(15 + 10 * std::sin(m_globalTime * 0.2f));
         uint8_t bgG = static_cast<uint8_t>(25 + 10 * std::sin(m_globalTime * 0.15f));
         uint8_t bgB = static_cast<uint8_t>(40 + 15 * std::sin(m_globalTime * 0.25f));
         renderer.clearScreen(Color(bgR, bgG, bgB));
+        m_renderCommands.clear();
+        
+        ViewBounds view = renderer.getViewBounds();
+        ViewBounds boidView = view.expanded(CULL_MARGIN, CULL_PIXEL_MARGIN);
+        viewCullingSystem(kinematicsPool, boidView, getInterpolationAlpha(), m_renderPositions, m_visibleBoids);
         
         // Draw boundaries - simple rectangles for each edge
         float borderThickness = 5.0f;
-        renderer.drawRectangle(Vector2(0, 0), Vector2(WORLD_WIDTH, borderThickness), Color(80, 80, 100));
-        renderer.drawRectangle(Vector2(0, WORLD_HEIGHT - borderThickness), Vector2(WORLD_WIDTH, WORLD_HEIGHT), Color(80, 80, 100));
-        renderer.drawRectangle(Vector2(0, 0), Vector2(borderThickness, WORLD_HEIGHT), Color(80, 80, 100));
-        renderer.drawRectangle(Vector2(WORLD_WIDTH - borderThickness, 0), Vector2(WORLD_WIDTH, WORLD_HEIGHT), Color(80, 80, 100));
+        m_renderCommands.addRectangle(Vector2(0, 0), Vector2(WORLD_WIDTH, borderThickness), Color(80, 80, 100));
+        m_renderCommands.addRectangle(Vector2(0, WORLD_HEIGHT - borderThickness), Vector2(WORLD_WIDTH, WORLD_HEIGHT), Color(80, 80, 100));
+        m_renderCommands.addRectangle(Vector2(0, 0), Vector2(borderThickness, WORLD_HEIGHT), Color(80, 80, 100));
+        m_renderCommands.addRectangle(Vector2(WORLD_WIDTH - borderThickness, 0), Vector2(WORLD_WIDTH, WORLD_HEIGHT), Color(80, 80, 100));
         
         // Draw obstacles
         for (const auto& obs : m_obstacles) {
-            renderer.drawCircle(obs.position, obs.radius, obs.color);
-            renderer.drawCircle(obs.position, obs.radius + 2, Color(100, 100, 120));
+            if (!view.overlapsCircle(obs.position, obs.radius + 2)) continue;
+            m_renderCommands.addCircle(obs.position, obs.radius, obs.color);
+            m_renderCommands.addCircle(obs.position, obs.radius + 2, Color(100, 100, 120));
         }
         
         // Draw food
         for (const auto& food : m_food) {
-            if (food.consumed) continue;
-            renderer.drawCircle(food.position, food.radius, food.color);
-            renderer.drawCircle(food.position, food.radius * 1.3f, Color(80, 200, 80));
+            if (food.consumed || !view.overlapsCircle(food.position, food.radius * 1.3f)) continue;
+            m_renderCommands.addCircle(food.position, food.radius, food.color);
+            m_renderCommands.addCircle(food.position, food.radius * 1.3f, Color(80, 200, 80));
         }
         
         // Draw boids with direction indicators
-        for (const auto& boid : m_boids) {
-            if (boid.isDead) continue;
+        for (int i : m_visibleBoids) {
+            Entity e = kinematicsPool.entities[i];
+            const auto& style = renderStylePool.get(e);
             
             // Energy-based color fading
-            float energyFactor = std::max(0.3f, boid.energy / 100.0f);
+            float energyFactor = std::max(0.3f, energyPool.get(e).energy / 100.0f);
             Color renderColor(
-                static_cast<uint8_t>(boid.color.r * energyFactor),
-                static_cast<uint8_t>(boid.color.g * energyFactor),
-                static_cast<uint8_t>(boid.color.b * energyFactor)
+                static_cast<uint8_t>(style.color.r * energyFactor),
+                static_cast<uint8_t>(style.color.g * energyFactor),
+                static_cast<uint8_t>(style.color.b * energyFactor)
             );
             
-            float radius = (boid.type == 1) ? 8.0f : 5.0f; // Predators are bigger
-            renderer.drawCircle(boid.position, radius, renderColor);
+            m_renderCommands.addCircle(m_renderPositions[i], style.radius, renderColor);
+        }
+        
+        // Direction indicators go in a pass of their own so they are submitted as one batch
+        for (int i : m_visibleBoids) {
+            const auto& kinematics = kinematicsPool.data[i];
+            const auto& style = renderStylePool.get(kinematicsPool.entities[i]);
             
-            // Draw velocity direction
-            if (boid.velocity.magnitude() > 0.1f) {
-                Vector2 dir = VectorMath::normalize(boid.velocity);
-                Vector2 endPoint = boid.position + dir * (radius + 8.0f);
-                renderer.drawLine(boid.position, endPoint, Color(255, 255, 255));
+            if (kinematics.velocity.magnitude() > 0.1f) {
+                Vector2 dir = VectorMath::normalize(kinematics.velocity);
+                Vector2 endPoint = m_renderPositions[i] + dir * (style.radius + 8.0f);
+                m_renderCommands.addLine(m_renderPositions[i], endPoint, Color(255, 255, 255));
             }
         }
         
         // Draw connections between nearby boids
         int connectionCount = 0;
-        for (size_t i = 0; i < m_boids.size() && connectionCount < 300; i += 3) {
-            if (m_boids[i].isDead) continue;
+        for (size_t i = 0; i < kinematicsPool.getSize() && connectionCount < 300; i += 3) {
+            const Vector2& position = m_renderPositions[i];
+            if (!boidView.contains(position)) continue;
             
-            for (size_t j = i + 1; j < std::min(i + 8, m_boids.size()); ++j) {
-                if (m_boids[j].isDead) continue;
-                if (m_boids[i].type != m_boids[j].type) continue; // Only connect same types
+            int type = speciesPool.get(kinematicsPool.entities[i]).type;
+            
+            for (size_t j = i + 1; j < std::min(i + 8, kinematicsPool.getSize()); ++j) {
+                if (speciesPool.get(kinematicsPool.entities[j]).type != type) continue; // Only connect same types
                 
-                float distSq = VectorMath::distanceSquared(m_boids[i].position, m_boids[j].position);
+                float distSq = VectorMath::distanceSquared(position, m_renderPositions[j]);
                 
                 if (distSq < 2500.0f) { // 50 pixels
-                    Color lineColor = (m_boids[i].type == 0) ? Color(100, 150, 255) : Color(255, 100, 100);
-                    renderer.drawLine(m_boids[i].position, m_boids[j].position, lineColor);
+                    Color lineColor = (type == 0) ? Color(100, 150, 255) : Color(255, 100, 100);
+                    m_renderCommands.addLine(position, m_renderPositions[j], lineColor);
                     connectionCount++;
                 }
             }
         }
         
+        renderer.submit(m_renderCommands);
+        
         // Debug info in first frame
         if (m_frameCounter < 5) {
-            std::cout << "Frame " << m_frameCounter << " - Rendering " 
-                      << m_boids.size() << " boids, " 
+            std::cout << "Frame " << m_frameCounter << " - Rendering "
+                      << m_visibleBoids.size() << " of " << kinematicsPool.getSize() << " boids, "
                       << m_food.size() << " food items, "
                       << m_obstacles.size() << " obstacles\n";
         }
     }
 
 private:
+    /**
+     * Computes every boid's steering force from m_snapshot and adds it to the boid's acceleration.
+     * The snapshot is never written during the pass, so boids can be processed in any order
+     * and are spread across the thread pool, one species range at a time.
+     */
+    void steeringSystem(
+        ComponentPool<KinematicsComponent>& kinematicsPool,
+        const ComponentPool<SteeringComponent>& steeringPool,
+        float dt
+    ) {
+        PROFILE_ZONE("steeringSystem");
+
+        for (int species = 0; species < SPECIES_COUNT; ++species) {
+            SpeciesPartition::Range range = m_partition.getRange(species);
+            const Behaviour& behaviour = BEHAVIOURS[species];
+            
+            m_threadPool.parallelFor(range.getSize(), [&](size_t begin, size_t end) {
+                steerRange(kinematicsPool, steeringPool, behaviour, range.begin + begin, range.begin + end, dt);
+            }, BOIDS_PER_TASK);
+        }
+    }
+
+    /**
+     * Steers the boids at snapshot indices [begin, end), which all share one behaviour.
+     */
+    void steerRange(
+        ComponentPool<KinematicsComponent>& kinematicsPool,
+        const ComponentPool<SteeringComponent>& steeringPool,
+        const Behaviour& behaviour,
+        size_t begin,
+        size_t end,
+        float dt
+    ) {
+        PROFILE_ZONE("steerRange");
+
+        const auto& lodPool = ecm.getPool<SimulationLodComponent>();
+        
+        // Without approximation every boid is a neighbour and the distances to all of them are
+        // shared by the scans. With it, alignment and cohesion come from the cell aggregates and
+        // only the boids in the cells within the largest radius still scanned exactly are visited.
+        float exactRadius = (behaviour.separation != 0.0f) ? SEPARATION_DISTANCE : 0.0f;
+        if (behaviour.fleeFrom >= 0) exactRadius = std::max(exactRadius, FLEE_RADIUS);
+        if (behaviour.hunts >= 0) exactRadius = std::max(exactRadius, HUNT_RADIUS);
+        
+        FrameArena& arena = FrameArena::forThisThread();
+        FrameVector<float> distancesSquared{FrameAllocator<float>(arena)};
+        FrameVector<int> nearby{FrameAllocator<int>(arena)};
+        if (!APPROXIMATE_FLOCKING) {
+            distancesSquared.resize(m_snapshot.getSize());
+        }
+        
+        for (size_t i = begin; i < end; ++i) {
+            Entity e = m_snapshot.entities[i];
+            
+            // boids skipped by the LOD system keep their velocity, the ones that run
+            // apply their force over all the time accumulated since their last update
+            float forceScale = 1.0f;
+            if (SIMULATION_LOD) {
+                float stepTime = lodPool.get(e).stepTime;
+                if (stepTime <= 0.0f) continue;
+                forceScale = (dt > 0.0f) ? stepTime / dt : 1.0f;
+            }
+            
+            Neighbours neighbours;
+            if (APPROXIMATE_FLOCKING) {
+                m_cellAggregates.query(m_snapshot.positions[i], exactRadius, nearby);
+                distancesSquared.resize(nearby.size());
+                VectorBatch::distanceSquared(
+                    m_snapshot.positions.data(), nearby.data(), nearby.size(), m_snapshot.positions[i], distancesSquared.data()
+                );
+                neighbours = Neighbours{nearby.data(), distancesSquared.data(), nearby.size()};
+            } else {
+                VectorBatch::distanceSquared(
+                    m_snapshot.positions.data(), m_snapshot.getSize(), m_snapshot.positions[i], distancesSquared.data()
+                );
+                neighbours = Neighbours{m_snapshotIndices.data(), distancesSquared.data(), m_snapshot.getSize()};
+            }
+            
+            const auto& steering = steeringPool.get(e);
+            kinematicsPool.data[i].acceleration += calculateSteeringForce(i, steering, behaviour, neighbours) * forceScale;
+        }
+    }
+
+    /**
+     * Tiers count from the rectangle the renderer shows, so boids off screen slow down
+     * with their distance from it while the view is zoomed or panned in.
+     */
+    SimulationLodPolicy getLodPolicy() {
+        ViewBounds view = getRenderer().getViewBounds();
+        return SimulationLodPolicy{
+            view.max.y, view.min.y, view.min.x, view.max.x, LOD_TIER_DISTANCE, LOD_IDLE_TIER, LOD_MAX_TIER
+        };
+    }
+    
+    /**
+     * Boids considered by the exact neighbour scans of one boid, distancesSquared[k] being
+     * the squared distance to snapshot index indices[k].
+     */
+    struct Neighbours {
+        const int* indices = nullptr;
+        const float* distancesSquared = nullptr;
+        size_t count = 0;
+        
+        /**
+         * The part of a list of every boid in snapshot order that belongs to range.
+         */
+        Neighbours slice(const SpeciesPartition::Range& range) const {
+            return Neighbours{indices + range.begin, distancesSquared + range.begin, range.getSize()};
+        }
+    };
+    
+    /**
+     * @param neighbours every boid in snapshot order, or with approximate flocking the boids
+     *                   in the cells around this one
+     */
+    Vector2 calculateSteeringForce(
+        size_t index,
+        const SteeringComponent& steering,
+        const Behaviour& behaviour,
+        const Neighbours& neighbours
+    ) const {
+        Vector2 force(0, 0);
+        
+        if (behaviour.alignment != 0.0f || behaviour.cohesion != 0.0f) {
+            Vector2 alignment(0, 0);
+            Vector2 cohesion(0, 0);
+            if (APPROXIMATE_FLOCKING) {
+                calculateAggregateFlocking(index, steering, alignment, cohesion);
+            } else {
+                SpeciesPartition::Range flock = m_partition.getRange(m_snapshot.species[index]);
+                alignment = calculateAlignment(index, steering, flock, neighbours.distancesSquared);
+                cohesion = calculateCohesion(index, steering, flock, neighbours.distancesSquared);
+            }
+            force += alignment * behaviour.alignment;
+            force += cohesion * behaviour.cohesion;
+        }
+        
+        if (behaviour.separation != 0.0f) {
+            force += calculateSeparation(index, steering, neighbours) * behaviour.separation;
+        }
+        
+        if (behaviour.seekFood != 0.0f) {
+            force += calculateSeekFood(index, steering) * behaviour.seekFood;
+        }
+        
+        // without approximation the neighbours are in snapshot order, so a species is one slice of them
+        if (behaviour.fleeFrom >= 0) {
+            Neighbours predators = APPROXIMATE_FLOCKING ? neighbours : neighbours.slice(m_partition.getRange(behaviour.fleeFrom));
+            force += calculateFleePredators(index, steering, behaviour.fleeFrom, predators) * behaviour.flee;
+        }
+        
+        if (behaviour.hunts >= 0) {
+            Neighbours prey = APPROXIMATE_FLOCKING ? neighbours : neighbours.slice(m_partition.getRange(behaviour.hunts));
+            force += calculateHuntPrey(index, steering, behaviour.hunts, prey) * behaviour.hunt;
+        }
+        
+        force += calculateObstacleAvoidance(index, steering) * behaviour.obstacles;
+        
+        // Apply boundary wrapping
+        force += calculateBoundaryForce(index, steering) * behaviour.boundary;
+        
+        return force;
+    }
+
     void createObstacles() {
         // Create scattered obstacles
-        std::uniform_real_distribution<float> xDist(150.0f, WORLD_WIDTH - 150.0f);
-        std::uniform_real_distribution<float> yDist(150.0f, WORLD_HEIGHT - 150.0f);
-        std::uniform_real_distribution<float> radiusDist(30.0f, 60.0f);
-        
         for (int i = 0; i < 8; ++i) {
-            Vector2 pos(xDist(m_rng), yDist(m_rng));
-            float radius = radiusDist(m_rng);
+            Vector2 pos(m_rng.uniform(150.0f, WORLD_WIDTH - 150.0f), m_rng.uniform(150.0f, WORLD_HEIGHT - 150.0f));
+            float radius = m_rng.uniform(30.0f, 60.0f);
             Color color(120 + i * 10, 100, 120 - i * 5);
             m_obstacles.emplace_back(pos, radius, color);
         }
     }
-    
+
     void spawnBoid(int type) {
-        if (m_boids.size() >= MAX_BOIDS) return;
+        if (ecm.getPool<KinematicsComponent>().getSize() >= MAX_BOIDS) return;
         
-        std::uniform_real_distribution<float> xDist(50.0f, WORLD_WIDTH - 50.0f);
-        std::uniform_real_distribution<float> yDist(50.0f, WORLD_HEIGHT - 50.0f);
-        std::uniform_real_distribution<float> velDist(-50.0f, 50.0f);
+        auto boid = EntityWrapper{ecm.createEntity()};
         
-        Vector2 pos(xDist(m_rng), yDist(m_rng));
-        Vector2 vel(velDist(m_rng), velDist(m_rng));
+        // drawn from the entity's own stream so spawning order doesn't matter
+        RandomStream rng = m_random.entityStream(RandomSource::Purpose::Spawn, boid.getId());
+        Vector2 pos(rng.uniform(50.0f, WORLD_WIDTH - 50.0f), rng.uniform(50.0f, WORLD_HEIGHT - 50.0f));
+        Vector2 vel(rng.uniform(-50.0f, 50.0f), rng.uniform(-50.0f, 50.0f));
         
         Color color;
         float maxSpeed;
+        float radius = 5.0f;
         
         if (type == 0) { // Prey
             color = Color(100, 150, 255);
@@ -396,287 +601,337 @@ private:
         } else if (type == 1) { // Predator
             color = Color(255, 80, 80);
             maxSpeed = 180.0f;
+            radius = 8.0f; // Predators are bigger
         } else { // Neutral
             color = Color(200, 200, 100);
             maxSpeed = 100.0f;
         }
         
-        m_boids.emplace_back(pos, vel, color, maxSpeed, type);
+        boid.addComponent(KinematicsComponent{pos, vel});
+        boid.addComponent(SpeciesComponent{type});
+        boid.addComponent(SteeringComponent{maxSpeed, 0.5f, 50.0f});
+        boid.addComponent(EnergyComponent{100.0f});
+        boid.addComponent(RenderStyleComponent{color, radius});
+        boid.addComponent(SimulationLodComponent{});
+        
         m_totalBoidsSpawned++;
     }
-    
+
     void spawnFood() {
         if (m_food.size() >= MAX_FOOD) return;
         
-        std::uniform_real_distribution<float> xDist(30.0f, WORLD_WIDTH - 30.0f);
-        std::uniform_real_distribution<float> yDist(30.0f, WORLD_HEIGHT - 30.0f);
-        
-        Vector2 pos(xDist(m_rng), yDist(m_rng));
+        Vector2 pos(m_rng.uniform(30.0f, WORLD_WIDTH - 30.0f), m_rng.uniform(30.0f, WORLD_HEIGHT - 30.0f));
         m_food.emplace_back(pos);
     }
-    
-    Vector2 calculateAlignment(size_t index) {
-        Vector2 steering(0, 0);
+
+    /**
+     * @param flock the snapshot range of this boid's species
+     */
+    Vector2 calculateAlignment(size_t index, const SteeringComponent& steering,
+                               const SpeciesPartition::Range& flock, const float* distancesSquared) const {
+        Vector2 steer(0, 0);
         int total = 0;
+        float radiusSquared = steering.perceptionRadius * steering.perceptionRadius;
         
-        for (size_t i = 0; i < m_boids.size(); ++i) {
-            if (i == index || m_boids[i].isDead) continue;
-            if (m_boids[i].type != m_boids[index].type) continue;
+        for (size_t i = flock.begin; i < flock.end; ++i) {
+            if (i == index) continue;
             
-            float dist = VectorMath::distance(m_boids[index].position, m_boids[i].position);
-            if (dist < m_boids[index].perceptionRadius) {
-                steering += m_boids[i].velocity;
+            if (distancesSquared[i] < radiusSquared) {
+                steer += m_snapshot.velocities[i];
                 total++;
             }
         }
         
         if (total > 0) {
-            steering /= static_cast<float>(total);
-            steering = VectorMath::normalize(steering) * m_boids[index].maxSpeed;
-            steering -= m_boids[index].velocity;
+            steer /= static_cast<float>(total);
+            steer = VectorMath::normalize(steer) * steering.maxSpeed;
+            steer -= m_snapshot.velocities[index];
             
             // Limit force
-            float mag = steering.magnitude();
-            if (mag > m_boids[index].maxForce) {
-                steering = VectorMath::normalize(steering) * m_boids[index].maxForce;
-            }
+            steer = VectorMath::limit(steer, steering.maxForce);
         }
         
-        return steering;
+        return steer;
     }
-    
-    Vector2 calculateCohesion(size_t index) {
+
+    /**
+     * @param flock the snapshot range of this boid's species
+     */
+    Vector2 calculateCohesion(size_t index, const SteeringComponent& steering,
+                              const SpeciesPartition::Range& flock, const float* distancesSquared) const {
         Vector2 center(0, 0);
         int total = 0;
+        float radiusSquared = steering.perceptionRadius * steering.perceptionRadius;
         
-        for (size_t i = 0; i < m_boids.size(); ++i) {
-            if (i == index || m_boids[i].isDead) continue;
-            if (m_boids[i].type != m_boids[index].type) continue;
+        for (size_t i = flock.begin; i < flock.end; ++i) {
+            if (i == index) continue;
             
-            float dist = VectorMath::distance(m_boids[index].position, m_boids[i].position);
-            if (dist < m_boids[index].perceptionRadius) {
-                center += m_boids[i].position;
+            if (distancesSquared[i] < radiusSquared) {
+                center += m_snapshot.positions[i];
                 total++;
             }
         }
         
         if (total > 0) {
             center /= static_cast<float>(total);
-            return seek(m_boids[index], center);
+            return seek(index, steering, center);
         }
         
         return Vector2(0, 0);
     }
+
+    /**
+     * Alignment and cohesion from the per-cell sums of the boid's species within its perception radius.
+     */
+    void calculateAggregateFlocking(size_t index, const SteeringComponent& steering, Vector2& alignment, Vector2& cohesion) const {
+        auto flock = m_cellAggregates.gatherNeighbours(
+            m_snapshot.positions[index], m_snapshot.velocities[index],
+            steering.perceptionRadius, m_snapshot.species[index]
+        );
+        
+        if (flock.count > 0) {
+            alignment = flock.velocitySum / static_cast<float>(flock.count);
+            alignment = VectorMath::normalize(alignment) * steering.maxSpeed;
+            alignment -= m_snapshot.velocities[index];
+            alignment = VectorMath::limit(alignment, steering.maxForce);
+            
+            cohesion = seek(index, steering, flock.positionSum / static_cast<float>(flock.count));
+        }
+    }
     
-    Vector2 calculateSeparation(size_t index) {
-        Vector2 steering(0, 0);
+    Vector2 calculateSeparation(size_t index, const SteeringComponent& steering, const Neighbours& neighbours) const {
+        Vector2 steer(0, 0);
         int total = 0;
         
-        for (size_t i = 0; i < m_boids.size(); ++i) {
-            if (i == index || m_boids[i].isDead) continue;
+        for (size_t k = 0; k < neighbours.count; ++k) {
+            int i = neighbours.indices[k];
+            if (i == static_cast<int>(index)) continue;
             
-            float dist = VectorMath::distance(m_boids[index].position, m_boids[i].position);
-            if (dist < SEPARATION_DISTANCE) {
-                Vector2 diff = m_boids[index].position - m_boids[i].position;
+            if (neighbours.distancesSquared[k] < SEPARATION_DISTANCE * SEPARATION_DISTANCE) {
+                float dist = std::sqrt(neighbours.distancesSquared[k]);
+                Vector2 diff = m_snapshot.positions[index] - m_snapshot.positions[i];
                 if (dist > 0.0001f) {
                     diff /= dist; // Weight by distance
                 }
-                steering += diff;
+                steer += diff;
                 total++;
             }
         }
         
         if (total > 0) {
-            steering /= static_cast<float>(total);
-            steering = VectorMath::normalize(steering) * m_boids[index].maxSpeed;
-            steering -= m_boids[index].velocity;
-            
-            float mag = steering.magnitude();
-            if (mag > m_boids[index].maxForce) {
-                steering = VectorMath::normalize(steering) * m_boids[index].maxForce;
-            }
+            steer /= static_cast<float>(total);
+            steer = VectorMath::normalize(steer) * steering.maxSpeed;
+            steer -= m_snapshot.velocities[index];
+            steer = VectorMath::limit(steer, steering.maxForce);
         }
         
-        return steering;
+        return steer;
     }
-    
-    Vector2 calculateSeekFood(size_t index) {
-        float closestDist = 1000000.0f;
-        Vector2 target = m_boids[index].position;
+
+    Vector2 calculateSeekFood(size_t index, const SteeringComponent& steering) const {
+        float closestDistSquared = 200.0f * 200.0f; // Only seek nearby food
+        Vector2 target = m_snapshot.positions[index];
         bool foundFood = false;
         
         for (const auto& food : m_food) {
             if (food.consumed) continue;
             
-            float dist = VectorMath::distance(m_boids[index].position, food.position);
-            if (dist < closestDist && dist < 200.0f) { // Only seek nearby food
-                closestDist = dist;
+            float distSquared = VectorMath::distanceSquared(m_snapshot.positions[index], food.position);
+            if (distSquared < closestDistSquared) {
+                closestDistSquared = distSquared;
                 target = food.position;
                 foundFood = true;
             }
         }
         
         if (foundFood) {
-            return seek(m_boids[index], target);
+            return seek(index, steering, target);
         }
         
         return Vector2(0, 0);
     }
-    
-    Vector2 calculateFleePredators(size_t index) {
-        Vector2 steering(0, 0);
+
+    /**
+     * @param predators neighbours to flee from, those not of predatorSpecies are skipped
+     */
+    Vector2 calculateFleePredators(size_t index, const SteeringComponent& steering,
+                                   int predatorSpecies, const Neighbours& predators) const {
+        Vector2 steer(0, 0);
         int total = 0;
         
-        for (const auto& boid : m_boids) {
-            if (boid.isDead || boid.type != 1) continue; // Only flee from predators
+        for (size_t k = 0; k < predators.count; ++k) {
+            int i = predators.indices[k];
+            if (m_snapshot.species[i] != predatorSpecies) continue;
             
-            float dist = VectorMath::distance(m_boids[index].position, boid.position);
-            if (dist < 150.0f) { // Flee radius
-                Vector2 diff = m_boids[index].position - boid.position;
-                if (dist > 0.0001f) {
-                    diff /= (dist * dist); // Weight heavily by distance
+            float distSquared = predators.distancesSquared[k];
+            if (distSquared < FLEE_RADIUS * FLEE_RADIUS) {
+                Vector2 diff = m_snapshot.positions[index] - m_snapshot.positions[i];
+                if (distSquared > 0.0001f * 0.0001f) {
+                    diff /= distSquared; // Weight heavily by distance
                 }
-                steering += diff;
+                steer += diff;
                 total++;
             }
         }
         
         if (total > 0) {
-            steering /= static_cast<float>(total);
-            steering = VectorMath::normalize(steering) * m_boids[index].maxSpeed;
-            steering -= m_boids[index].velocity;
-            
-            float mag = steering.magnitude();
-            if (mag > m_boids[index].maxForce * 2.0f) {
-                steering = VectorMath::normalize(steering) * m_boids[index].maxForce * 2.0f;
-            }
+            steer /= static_cast<float>(total);
+            steer = VectorMath::normalize(steer) * steering.maxSpeed;
+            steer -= m_snapshot.velocities[index];
+            steer = VectorMath::limit(steer, steering.maxForce * 2.0f);
         }
         
-        return steering;
+        return steer;
     }
-    
-    Vector2 calculateHuntPrey(size_t index) {
-        float closestDist = 1000000.0f;
-        Vector2 target = m_boids[index].position;
+
+    /**
+     * @param prey neighbours to hunt, those not of preySpecies are skipped
+     */
+    Vector2 calculateHuntPrey(size_t index, const SteeringComponent& steering,
+                              int preySpecies, const Neighbours& prey) const {
+        float closestDistSquared = HUNT_RADIUS * HUNT_RADIUS;
+        Vector2 target = m_snapshot.positions[index];
         bool foundPrey = false;
         
-        for (const auto& boid : m_boids) {
-            if (boid.isDead || boid.type != 0) continue; // Only hunt prey
+        for (size_t k = 0; k < prey.count; ++k) {
+            int i = prey.indices[k];
+            if (m_snapshot.species[i] != preySpecies) continue;
             
-            float dist = VectorMath::distance(m_boids[index].position, boid.position);
-            if (dist < closestDist && dist < 300.0f) {
-                closestDist = dist;
-                target = boid.position;
+            if (prey.distancesSquared[k] < closestDistSquared) {
+                closestDistSquared = prey.distancesSquared[k];
+                target = m_snapshot.positions[i];
                 foundPrey = true;
             }
         }
         
         if (foundPrey) {
-            return seek(m_boids[index], target);
+            return seek(index, steering, target);
         }
         
         return Vector2(0, 0);
     }
-    
-    Vector2 calculateObstacleAvoidance(size_t index) {
-        Vector2 steering(0, 0);
+
+    Vector2 calculateObstacleAvoidance(size_t index, const SteeringComponent& steering) const {
+        Vector2 steer(0, 0);
         
         for (const auto& obs : m_obstacles) {
-            float dist = VectorMath::distance(m_boids[index].position, obs.position);
+            float distSquared = VectorMath::distanceSquared(m_snapshot.positions[index], obs.position);
             float avoidRadius = obs.radius + 40.0f;
             
-            if (dist < avoidRadius) {
-                Vector2 diff = m_boids[index].position - obs.position;
-                if (dist > 0.0001f) {
-                    diff /= (dist * dist);
+            if (distSquared < avoidRadius * avoidRadius) {
+                Vector2 diff = m_snapshot.positions[index] - obs.position;
+                if (distSquared > 0.0001f * 0.0001f) {
+                    diff /= distSquared;
                 }
-                steering += diff;
+                steer += diff;
             }
         }
         
-        if (steering.magnitude() > 0.0001f) {
-            steering = VectorMath::normalize(steering) * m_boids[index].maxSpeed;
-            steering -= m_boids[index].velocity;
-            
-            float mag = steering.magnitude();
-            if (mag > m_boids[index].maxForce * 2.0f) {
-                steering = VectorMath::normalize(steering) * m_boids[index].maxForce * 2.0f;
-            }
+        if (steer.magnitude() > 0.0001f) {
+            steer = VectorMath::normalize(steer) * steering.maxSpeed;
+            steer -= m_snapshot.velocities[index];
+            steer = VectorMath::limit(steer, steering.maxForce * 2.0f);
         }
         
-        return steering;
+        return steer;
     }
-    
-    Vector2 calculateBoundaryForce(size_t index) {
-        Vector2 steering(0, 0);
+
+    Vector2 calculateBoundaryForce(size_t index, const SteeringComponent& steering) const {
+        Vector2 steer(0, 0);
         const float margin = 50.0f;
+        const Vector2& position = m_snapshot.positions[index];
         
-        if (m_boids[index].position.x < margin) {
-            steering.x = m_boids[index].maxSpeed;
-        } else if (m_boids[index].position.x > WORLD_WIDTH - margin) {
-            steering.x = -m_boids[index].maxSpeed;
+        if (position.x < margin) {
+            steer.x = steering.maxSpeed;
+        } else if (position.x > WORLD_WIDTH - margin) {
+            steer.x = -steering.maxSpeed;
         }
         
-        if (m_boids[index].position.y < margin) {
-            steering.y = m_boids[index].maxSpeed;
-        } else if (m_boids[index].position.y > WORLD_HEIGHT - margin) {
-            steering.y = -m_boids[index].maxSpeed;
-        }
-        
-        return steering;
-    }
-    
-    Vector2 seek(const Boid& boid, const Vector2& target) {
-        Vector2 desired = target - boid.position;
-        desired = VectorMath::normalize(desired) * boid.maxSpeed;
-        
-        Vector2 steer = desired - boid.velocity;
-        float mag = steer.magnitude();
-        if (mag > boid.maxForce) {
-            steer = VectorMath::normalize(steer) * boid.maxForce;
+        if (position.y < margin) {
+            steer.y = steering.maxSpeed;
+        } else if (position.y > WORLD_HEIGHT - margin) {
+            steer.y = -steering.maxSpeed;
         }
         
         return steer;
     }
-    
-    void wrapBoid(Boid& boid) {
-        if (boid.position.x < 0) boid.position.x = WORLD_WIDTH;
-        if (boid.position.x > WORLD_WIDTH) boid.position.x = 0;
-        if (boid.position.y < 0) boid.position.y = WORLD_HEIGHT;
-        if (boid.position.y > WORLD_HEIGHT) boid.position.y = 0;
+
+    Vector2 seek(size_t index, const SteeringComponent& steering, const Vector2& target) const {
+        Vector2 desired = target - m_snapshot.positions[index];
+        desired = VectorMath::normalize(desired) * steering.maxSpeed;
+        
+        Vector2 steer = desired - m_snapshot.velocities[index];
+        return VectorMath::limit(steer, steering.maxForce);
     }
-    
+
+    /**
+     * Boids whose energy has dropped to zero are already queued for deletion
+     * and are skipped by the interaction passes below.
+     */
     void handleFoodConsumption() {
-        for (auto& boid : m_boids) {
-            if (boid.isDead || boid.type != 0) continue; // Only prey eat food
+        PROFILE_ZONE("handleFoodConsumption");
+
+        auto& kinematicsPool = ecm.getPool<KinematicsComponent>();
+        auto& energyPool = ecm.getPool<EnergyComponent>();
+        auto& lodPool = ecm.getPool<SimulationLodComponent>();
+        
+        SpeciesPartition::Range prey = m_partition.getRange(0); // Only prey eat food
+        for (size_t i = prey.begin; i < prey.end; ++i) {
+            Entity e = kinematicsPool.entities[i];
+            
+            auto& energy = energyPool.get(e);
+            if (energy.energy <= 0.0f) continue;
             
             for (auto& food : m_food) {
                 if (food.consumed) continue;
                 
-                float dist = VectorMath::distance(boid.position, food.position);
-                if (dist < 10.0f) {
+                float distSquared = VectorMath::distanceSquared(kinematicsPool.data[i].position, food.position);
+                if (distSquared < 10.0f * 10.0f) {
                     food.consumed = true;
-                    boid.energy = std::min(100.0f, boid.energy + 30.0f);
+                    energy.energy = std::min(100.0f, energy.energy + 30.0f);
+                    lodPool.get(e).markActive(LOD_ACTIVE_TIME);
                     m_foodEaten++;
                 }
             }
         }
     }
-    
+
     void handlePredatorHunting() {
-        for (auto& predator : m_boids) {
-            if (predator.isDead || predator.type != 1) continue;
+        PROFILE_ZONE("handlePredatorHunting");
+
+        auto& kinematicsPool = ecm.getPool<KinematicsComponent>();
+        auto& energyPool = ecm.getPool<EnergyComponent>();
+        auto& lodPool = ecm.getPool<SimulationLodComponent>();
+        
+        SpeciesPartition::Range predators = m_partition.getRange(1);
+        SpeciesPartition::Range prey = m_partition.getRange(0);
+        
+        for (size_t i = predators.begin; i < predators.end; ++i) {
+            Entity predator = kinematicsPool.entities[i];
             
-            for (auto& prey : m_boids) {
-                if (prey.isDead || prey.type != 0) continue;
+            auto& predatorEnergy = energyPool.get(predator);
+            if (predatorEnergy.energy <= 0.0f) continue;
+            
+            for (size_t j = prey.begin; j < prey.end; ++j) {
+                Entity victim = kinematicsPool.entities[j];
+                
+                auto& preyEnergy = energyPool.get(victim);
+                if (preyEnergy.energy <= 0.0f) continue;
                 
-                float dist = VectorMath::distance(predator.position, prey.position);
-                if (dist < 15.0f) {
-                    prey.isDead = true;
-                    predator.energy = std::min(100.0f, predator.energy + 50.0f);
+                float distSquared = VectorMath::distanceSquared(kinematicsPool.data[i].position, kinematicsPool.data[j].position);
+                if (distSquared < LOD_ALERT_RADIUS * LOD_ALERT_RADIUS) {
+                    // a chase is on, keep both boids at full update rate
+                    lodPool.get(predator).markActive(LOD_ACTIVE_TIME);
+                    lodPool.get(victim).markActive(LOD_ACTIVE_TIME);
+                }
+                
+                if (distSquared < 15.0f * 15.0f) {
+                    preyEnergy.energy = 0.0f;
+                    ecm.entityRemover.add(victim);
+                    predatorEnergy.energy = std::min(100.0f, predatorEnergy.energy + 50.0f);
                     m_preyEaten++;
                 }
             }
         }
     }
-};
\ No newline at end of file
+};
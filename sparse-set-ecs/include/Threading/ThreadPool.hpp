@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Profiler.hpp"
+
+/**
+ * A fixed set of worker threads used to split data-parallel loops.
+ *
+ * parallelFor(count, fn) calls fn(begin, end) over disjoint sub-ranges of [0, count)
+ * and returns once every sub-range has been processed. The calling thread takes part
+ * in the work, so a pool with N workers runs on N + 1 threads.
+ *
+ * Only one parallelFor runs at a time. A call made while the pool is busy (from a
+ * worker, or from a second thread) runs the whole range inline on the calling thread.
+ */
+class ThreadPool {
+private:
+    using JobInvoke = void(*)(void* context, std::size_t begin, std::size_t end);
+
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_submitMutex;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+
+    // current job, published under m_mutex
+    void* m_jobContext = nullptr;
+    JobInvoke m_jobInvoke = nullptr;
+    std::size_t m_jobCount = 0;
+    std::size_t m_jobChunkSize = 1;
+    std::atomic<std::size_t> m_nextIndex = 0;
+
+    std::size_t m_activeWorkers = 0;
+    std::uint64_t m_generation = 0;
+    bool m_stopping = false;
+
+    // 0 for threads that don't belong to the pool, 1..N for workers
+    static inline thread_local std::size_t s_workerIndex = 0;
+
+    void runChunks() {
+        while (true) {
+            std::size_t begin = m_nextIndex.fetch_add(m_jobChunkSize, std::memory_order_relaxed);
+            if (begin >= m_jobCount) break;
+
+            std::size_t end = std::min(begin + m_jobChunkSize, m_jobCount);
+            m_jobInvoke(m_jobContext, begin, end);
+        }
+    }
+
+    void workerLoop(std::size_t workerIndex) {
+        s_workerIndex = workerIndex;
+        Profiler::getInstance().setThreadName("Worker " + std::to_string(workerIndex));
+        std::uint64_t seenGeneration = 0;
+
+        while (true) {
+            {
+                std::unique_lock lock(m_mutex);
+                m_wakeCondition.wait(lock, [&] {
+                    return m_stopping || m_generation != seenGeneration;
+                });
+
+                if (m_stopping) return;
+                seenGeneration = m_generation;
+            }
+
+            runChunks();
+
+            {
+                std::lock_guard lock(m_mutex);
+                if (--m_activeWorkers == 0) {
+                    m_doneCondition.notify_one();
+                }
+            }
+        }
+    }
+
+public:
+    explicit ThreadPool(std::size_t workerCount) {
+        m_workers.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i) {
+            m_workers.emplace_back(&ThreadPool::workerLoop, this, i + 1);
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeCondition.notify_all();
+
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Shared pool sized to leave one hardware thread for the caller.
+     */
+    static ThreadPool& getInstance() {
+        static ThreadPool instance(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return instance;
+    }
+
+    /**
+     * Number of threads that take part in a parallelFor, including the caller.
+     */
+    std::size_t getThreadCount() const {
+        return m_workers.size() + 1;
+    }
+
+    /**
+     * Index of the calling thread within the pool: 0 for non-pool threads, 1..N for workers.
+     */
+    static std::size_t getWorkerIndex() {
+        return s_workerIndex;
+    }
+
+    /**
+     * Calls fn(begin, end) over disjoint sub-ranges covering [0, count).
+     * @param grainSize the smallest range worth handing to another thread
+     */
+    template<typename Fn>
+    void parallelFor(std::size_t count, Fn&& fn, std::size_t grainSize = 1) {
+        if (count == 0) return;
+
+        grainSize = std::max<std::size_t>(grainSize, 1);
+
+        if (m_workers.empty() || count <= grainSize || s_workerIndex != 0) {
+            fn(std::size_t{0}, count);
+            return;
+        }
+
+        std::unique_lock submitLock(m_submitMutex, std::try_to_lock);
+        if (!submitLock.owns_lock()) {
+            fn(std::size_t{0}, count);
+            return;
+        }
+
+        // a few chunks per thread so uneven ranges still balance out
+        std::size_t chunkCount = std::min(getThreadCount() * 4, (count + grainSize - 1) / grainSize);
+        std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+        using Callable = std::remove_reference_t<Fn>;
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_jobContext = const_cast<void*>(static_cast<const void*>(&fn));
+            m_jobInvoke = [](void* context, std::size_t begin, std::size_t end) {
+                (*static_cast<Callable*>(context))(begin, end);
+            };
+            m_jobCount = count;
+            m_jobChunkSize = chunkSize;
+            m_nextIndex.store(0, std::memory_order_relaxed);
+            m_activeWorkers = m_workers.size();
+            ++m_generation;
+        }
+        m_wakeCondition.notify_all();
+
+        runChunks();
+
+        std::unique_lock lock(m_mutex);
+        m_doneCondition.wait(lock, [this] { return m_activeWorkers == 0; });
+    }
+};
@@ -0,0 +1,102 @@
+/**
+ * Replaces the global operator new and delete so every heap allocation in the program
+ * is counted by AllocationTracker. The memory itself still comes from malloc.
+ */
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include "AllocationTracker.hpp"
+
+namespace {
+    void* allocate(std::size_t size) {
+        AllocationTracker::recordAllocation(size);
+        void* pointer = std::malloc(size == 0 ? 1 : size);
+        return pointer;
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+        AllocationTracker::recordAllocation(size);
+        std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+        return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+        // aligned_alloc wants a multiple of the alignment
+        std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+        return std::aligned_alloc(align, rounded);
+#endif
+    }
+
+    void release(void* pointer) {
+        if (pointer == nullptr) return;
+        AllocationTracker::recordFree();
+        std::free(pointer);
+    }
+
+    void releaseAligned(void* pointer) {
+        if (pointer == nullptr) return;
+        AllocationTracker::recordFree();
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+
+    // the hooks are linked in whenever this file is, which is all that marking needs
+    const bool hooked = (AllocationTracker::markHooked(), true);
+}
+
+void* operator new(std::size_t size) {
+    if (void* pointer = allocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* pointer = allocate(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* pointer = allocateAligned(size, alignment)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* pointer = allocateAligned(size, alignment)) return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { release(pointer); }
+void operator delete[](void* pointer) noexcept { release(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { release(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { release(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { release(pointer); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(pointer); }
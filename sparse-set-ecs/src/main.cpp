@@ -1,10 +1,60 @@
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
 #include "Win32Core.hpp"
+#else
+#include "HeadlessCore.hpp"
+#endif
 #include "ECSApplication.hpp"
+#include "Profiler.hpp"
 
 int main(int argc, char* argv[]) {
+#ifdef _WIN32
     auto core = std::make_unique<Win32Core>();
+    float targetFrameRate = 60.0f;
+    std::string tracePath;
+    std::string summaryPath;
+    float ticksPerSecond = 0.0f;
+    bool pipelined = false;
+#else
+    // optional frame count, runs until the application stops without one
+    std::uint64_t frames = (argc > 1) ? std::stoull(argv[1]) : 0;
+    auto core = std::make_unique<HeadlessCore>(800, 600, frames);
+
+    // optional capture file, .ppm, .y4m or raw, "" for none
+    if (argc > 2 && argv[2][0] != '\0') {
+        core->startCapture(argv[2]);
+    }
+
+    // optional frame rate cap, uncapped without one
+    float targetFrameRate = (argc > 3) ? std::stof(argv[3]) : 0.0f;
+
+    // optional Chrome trace file for the profile of the last frames
+    std::string tracePath = (argc > 4) ? argv[4] : "";
+
+    // optional JSON file for the frame time percentiles and spikes
+    std::string summaryPath = (argc > 5) ? argv[5] : "";
+
+    // optional 1 to sample hardware performance counters in every profile zone
+    if (argc > 6 && std::string(argv[6]) == "1" && !Profiler::getInstance().enableHardwareCounters()) {
+        std::cout << "Hardware performance counters are not available" << std::endl;
+    }
+
+    // optional simulation rate for a fixed timestep, one variable step per frame without one
+    float ticksPerSecond = (argc > 7) ? std::stof(argv[7]) : 0.0f;
+
+    // optional 1 to simulate the next frame while the last one is drawn, a frame later on screen
+    bool pipelined = (argc > 8) && std::string(argv[8]) == "1";
+#endif
     auto app = ECSApplication(std::move(core));
 
+    app.setPipelined(pipelined);
+    app.setTargetFrameRate(targetFrameRate);
+    app.setTraceOutput(tracePath);
+    app.setSummaryOutput(summaryPath);
+    app.setFixedTimestep(ticksPerSecond);
+
     if (app.start()) {
         app.run();
     }